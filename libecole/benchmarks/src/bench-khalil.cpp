@@ -0,0 +1,47 @@
+#include <chrono>
+#include <optional>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-khalil.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+auto KhalilResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(), make_csv("n_extractions", "extract:wall_time_s", "extract:mean_wall_time_s"));
+}
+
+auto KhalilResult::csv() -> std::string {
+	auto const mean_wall_time_s =
+		n_extractions > 0 ? extract_wall_time_s / static_cast<double>(n_extractions) : extract_wall_time_s;
+	return merge_csv(instance.csv(), make_csv(n_extractions, extract_wall_time_s, mean_wall_time_s));
+}
+
+auto benchmark_khalil(scip::Model const& model) -> KhalilResult {
+	auto result = KhalilResult{InstanceFeatures::from_model(model.copy_orig())};
+
+	auto solve_model = model.copy_orig();
+	auto dyn = dynamics::BranchingDynamics{};
+	auto obs_func = observation::Khalil2016{};
+	auto obs = std::optional<observation::Khalil2016Obs>{};
+	obs_func.before_reset(solve_model);
+	auto [done, action_set] = dyn.reset_dynamics(solve_model);
+	while (!done) {
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		obs_func.extract_into(solve_model, done, obs);
+		auto const wall_time_after = std::chrono::steady_clock::now();
+		result.extract_wall_time_s += std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+		result.n_extractions++;
+		std::tie(done, action_set) = dyn.step_dynamics(solve_model, action_set.value()[0]);
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
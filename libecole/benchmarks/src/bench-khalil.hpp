@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct KhalilResult {
+	InstanceFeatures instance;
+	std::size_t n_extractions = 0;
+	double extract_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the latency of Khalil2016 observation extraction on a given model.
+ *
+ * The model is solved with the branching dynamics, always branching on the first candidate, and the observation is
+ * extracted on every node.
+ * Only the time spent extracting observations is measured.
+ */
+auto benchmark_khalil(scip::Model const& model) -> KhalilResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <optional>
+#include <tuple>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-node-bipartite.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+auto NodeBipartiteResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("n_extractions", "full:wall_time_s", "incremental:wall_time_s", "incremental:speedup"));
+}
+
+auto NodeBipartiteResult::csv() -> std::string {
+	auto const speedup = incremental_wall_time_s > 0 ? full_wall_time_s / incremental_wall_time_s : 0.;
+	return merge_csv(instance.csv(), make_csv(n_extractions, full_wall_time_s, incremental_wall_time_s, speedup));
+}
+
+namespace {
+
+/** Extract an observation and return the wall time it took. */
+template <typename ObsFunc, typename Obs> auto time_extract_into(ObsFunc& obs_func, scip::Model& model, Obs& obs) {
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	obs_func.extract_into(model, false, obs);
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+}
+
+}  // namespace
+
+auto benchmark_node_bipartite(scip::Model const& model) -> NodeBipartiteResult {
+	auto result = NodeBipartiteResult{InstanceFeatures::from_model(model.copy_orig())};
+
+	auto solve_model = model.copy_orig();
+	solve_model.set_params({
+		{"separating/maxrounds", -1},
+		{"separating/gomory/freq", 1},
+		{"separating/cmir/freq", 1},
+	});
+	auto dyn = dynamics::BranchingDynamics{};
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{false, true};
+	auto full_obs = std::optional<observation::NodeBipartiteObs>{};
+	auto incremental_obs = std::optional<observation::NodeBipartiteObs>{};
+	full_func.before_reset(solve_model);
+	incremental_func.before_reset(solve_model);
+	auto [done, action_set] = dyn.reset_dynamics(solve_model);
+	while (!done) {
+		result.full_wall_time_s += time_extract_into(full_func, solve_model, full_obs);
+		result.incremental_wall_time_s += time_extract_into(incremental_func, solve_model, incremental_obs);
+		result.n_extractions++;
+		std::tie(done, action_set) = dyn.step_dynamics(solve_model, action_set.value()[0]);
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct NodeBipartiteResult {
+	InstanceFeatures instance;
+	std::size_t n_extractions = 0;
+	double full_wall_time_s = 0.;
+	double incremental_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark incremental NodeBipartite extraction against full extraction on a given model.
+ *
+ * The model is solved with the branching dynamics, always branching on the first candidate, and both observations are
+ * extracted on every node.
+ * Cutting planes are separated on every node so that LP rows change along the episode.
+ * Only the time spent extracting observations is measured.
+ */
+auto benchmark_node_bipartite(scip::Model const& model) -> NodeBipartiteResult;
+
+}  // namespace ecole::benchmark
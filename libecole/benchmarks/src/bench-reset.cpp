@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-reset.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Wall time taken to run the function concurrently in the given number of threads. */
+template <typename Func> auto measure_in_threads(Func const& func_to_bench, std::size_t n_threads) -> double {
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(n_threads);
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		threads.emplace_back(func_to_bench);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+}
+
+}  // namespace
+
+auto ResetResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("n_threads", "n_resets", "copy:wall_time_s", "reset:wall_time_s", "reset:resets_per_s"));
+}
+
+auto ResetResult::csv() -> std::string {
+	auto const resets_per_s = reset_wall_time_s > 0. ? static_cast<double>(n_resets) / reset_wall_time_s : 0.;
+	return merge_csv(instance.csv(), make_csv(n_threads, n_resets, copy_wall_time_s, reset_wall_time_s, resets_per_s));
+}
+
+auto benchmark_reset(scip::Model const& model, std::size_t n_threads, std::size_t n_resets_per_thread) -> ResetResult {
+	auto const copy_many = [&model, n_resets_per_thread]() {
+		for (std::size_t i = 0; i < n_resets_per_thread; ++i) {
+			[[maybe_unused]] auto const copy = model.copy_orig();
+		}
+	};
+	auto const reset_many = [&model, n_resets_per_thread]() {
+		auto env = environment::Branching<observation::Nothing>{};
+		for (std::size_t i = 0; i < n_resets_per_thread; ++i) {
+			env.reset(model);
+		}
+	};
+
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		n_threads,
+		n_threads * n_resets_per_thread,
+		measure_in_threads(copy_many, n_threads),
+		measure_in_threads(reset_many, n_threads),
+	};
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct ResetResult {
+	InstanceFeatures instance;
+	std::size_t n_threads = 0;
+	std::size_t n_resets = 0;
+	double copy_wall_time_s = 0.;
+	double reset_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark environment resets run concurrently on a shared model.
+ *
+ * Each of the threads performs the given number of resets of its own environment, all from the same model.
+ * The copies alone, and the full resets are timed separately.
+ */
+auto benchmark_reset(scip::Model const& model, std::size_t n_threads, std::size_t n_resets_per_thread) -> ResetResult;
+
+}  // namespace ecole::benchmark
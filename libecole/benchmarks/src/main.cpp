@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <optional>
+#include <thread>
 #include <tuple>
 
 #include <CLI/CLI.hpp>
@@ -13,6 +15,9 @@
 #include "ecole/scip/seed.hpp"
 
 #include "bench-branching.hpp"
+#include "bench-khalil.hpp"
+#include "bench-node-bipartite.hpp"
+#include "bench-reset.hpp"
 #include "benchmark.hpp"
 
 using namespace ecole::benchmark;
@@ -69,6 +74,90 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 	}
 }
 
+/** Latency of Khalil2016 observation extraction against problem size. */
+auto benchmark_khalil(std::size_t n_instances, std::size_t n_nodes) {
+	auto generators = std::tuple{
+		SetCoverGenerator{{500, 1000}},                    // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{1000, 2000}},                   // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{2000, 4000}},                   // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{4000, 8000}},                   // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{100, 500}},         // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{200, 1000}},        // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{400, 2000}},        // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{100, 100}},  // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{200, 100}},  // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{400, 100}},  // NOLINT(readability-magic-numbers)
+	};
+	auto rng = ecole::spawn_random_generator();
+
+	std::cout << KhalilResult::csv_title() << '\n';
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		auto benchmark_and_print = [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				std::cout << benchmark_khalil(model).csv() << '\n';
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		};
+		for_each(generators, benchmark_and_print);
+	}
+}
+
+/** Time of incremental NodeBipartite extraction compared to full extraction, when LP rows change. */
+auto benchmark_node_bipartite(std::size_t n_instances, std::size_t n_nodes) {
+	auto generators = std::tuple{
+		SetCoverGenerator{{500, 1000}},                    // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{1000, 2000}},                   // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{100, 500}},         // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{200, 1000}},        // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{100, 100}},  // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{200, 100}},  // NOLINT(readability-magic-numbers)
+	};
+	auto rng = ecole::spawn_random_generator();
+
+	std::cout << NodeBipartiteResult::csv_title() << '\n';
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		auto benchmark_and_print = [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				std::cout << benchmark_node_bipartite(model).csv() << '\n';
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		};
+		for_each(generators, benchmark_and_print);
+	}
+}
+
+/** Scaling of concurrent environment resets from a shared model. */
+auto benchmark_reset(std::size_t n_instances, std::size_t max_threads, std::size_t n_resets) {
+	auto generators = std::tuple{
+		SetCoverGenerator{{500, 1000}},                    // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{100, 500}},         // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{100, 100}},  // NOLINT(readability-magic-numbers)
+	};
+
+	std::cout << ResetResult::csv_title() << '\n';
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		auto benchmark_and_print = [&](auto& gen) noexcept {
+			try {
+				auto const model = gen.next();
+				for (std::size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+					std::cout << benchmark_reset(model, n_threads, n_resets).csv() << '\n';
+				}
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		};
+		for_each(generators, benchmark_and_print);
+	}
+}
+
 int main(int argc, char** argv) {
 	try {
 
@@ -78,15 +167,38 @@ int main(int argc, char** argv) {
 		app.add_option(
 			"--intances-per-generator,--ipg", n_instances, "Number of instances generated by each instance generator");
 		auto n_nodes = std::size_t{100};  // NOLINT(readability-magic-numbers)
-		app.add_option("--node-limit,--nl", n_nodes, "Limit the number of nodes in each run");
+		app.add_option(
+			"--node-limit,--nl",
+			n_nodes,
+			"Limit the number of nodes in each run, shared by the branching, khalil, and node-bipartite benchmarks");
 		auto seed = std::optional<ecole::Seed>{};
 		app.add_option("--seed,-s", seed, "Global Ecole random seed");
+		auto* reset_app = app.add_subcommand("reset", "Benchmark concurrent environment resets instead of branching");
+		auto max_threads = std::size_t{std::max(std::thread::hardware_concurrency(), 1U)};
+		reset_app->add_option("--max-threads,--mt", max_threads, "Largest number of threads resetting concurrently");
+		auto n_resets = std::size_t{20};  // NOLINT(readability-magic-numbers)
+		reset_app->add_option("--resets-per-thread,--rpt", n_resets, "Number of resets performed by each thread");
+		auto* khalil_app = app.add_subcommand(
+			"khalil",
+			"Benchmark Khalil2016 extraction instead of branching, on the nodes allowed by the global --node-limit");
+		auto* node_bipartite_app = app.add_subcommand(
+			"node-bipartite",
+			"Benchmark incremental against full NodeBipartite extraction instead of branching, on the nodes allowed by "
+			"the global --node-limit");
 		CLI11_PARSE(app, argc, argv);
 
 		if (seed.has_value()) {
 			ecole::seed(seed.value());
 		}
-		benchmark_branching(n_instances, n_nodes);
+		if (reset_app->parsed()) {
+			benchmark_reset(n_instances, max_threads, n_resets);
+		} else if (khalil_app->parsed()) {
+			benchmark_khalil(n_instances, n_nodes);
+		} else if (node_bipartite_app->parsed()) {
+			benchmark_node_bipartite(n_instances, n_nodes);
+		} else {
+			benchmark_branching(n_instances, n_nodes);
+		}
 
 	} catch (std::exception const& e) {
 		std::cerr << "An error occured: " << e.what() << '\n';
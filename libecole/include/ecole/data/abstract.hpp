@@ -3,3 +3,7 @@
 namespace ecole::scip {
 class Model;
 }
+
+namespace ecole::data {
+class StepContext;
+}
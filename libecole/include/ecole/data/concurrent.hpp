@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::data::internal {
+
+/**
+ * Run tasks concurrently on the process-wide thread pool and wait for all of them.
+ *
+ * The last task runs on the calling thread.
+ * If tasks throw, the first exception (in task order) is rethrown once all tasks are finished.
+ */
+inline auto run_concurrently(std::vector<std::function<void()>>& tasks) -> void {
+	if (tasks.empty()) {
+		return;
+	}
+	auto futures = std::vector<std::future<void>>{};
+	futures.reserve(tasks.size() - 1);
+	for (std::size_t i = 0; i + 1 < tasks.size(); ++i) {
+		futures.push_back(utility::ThreadPool::global().submit(std::move(tasks[i])));
+	}
+
+	auto errors = std::vector<std::exception_ptr>(tasks.size());
+	try {
+		tasks.back()();
+	} catch (...) {
+		errors.back() = std::current_exception();
+	}
+	for (std::size_t i = 0; i < futures.size(); ++i) {
+		try {
+			futures[i].get();
+		} catch (...) {
+			errors[i] = std::current_exception();
+		}
+	}
+	for (auto const& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+/** Run tasks in order on the calling thread. */
+inline auto run_sequentially(std::vector<std::function<void()>>& tasks) -> void {
+	for (auto& task : tasks) {
+		task();
+	}
+}
+
+/**
+ * Run tasks in order, except that consecutive read-only tasks run concurrently.
+ *
+ * Tasks that are not read-only hence never run concurrently with any other task, and see the model in the same state
+ * as with a sequential execution.
+ * Since they may change the model, prepare is called on this thread before each group of concurrent tasks.
+ * It returns whether the group can indeed run concurrently, otherwise its tasks run in order on this thread.
+ */
+template <typename Prepare>
+auto run_read_only_concurrently(
+	std::vector<std::function<void()>> tasks,
+	std::vector<bool> const& read_only,
+	Prepare&& prepare) -> void {
+	auto batch = std::vector<std::function<void()>>{};
+	auto const run_batch = [&batch, &prepare] {
+		if ((batch.size() > 1) && !prepare()) {
+			run_sequentially(batch);
+		} else {
+			run_concurrently(batch);
+		}
+		batch.clear();
+	};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		if (read_only[i]) {
+			batch.push_back(std::move(tasks[i]));
+		} else {
+			run_batch();
+			tasks[i]();
+		}
+	}
+	run_batch();
+}
+
+}  // namespace ecole::data::internal
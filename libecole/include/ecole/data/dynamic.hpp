@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/step-context.hpp"
 
 namespace ecole::data {
 
@@ -47,6 +48,11 @@ public:
 	/** Call ``extract`` onto the wrapped item. */
 	auto extract(scip::Model& model, bool done) -> Data { return m_pimpl->extract(model, done); }
 
+	/** Call ``extract_in_context`` onto the wrapped item, or ``extract`` if it does not have one. */
+	auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> Data {
+		return m_pimpl->extract_in_context(model, done, context);
+	}
+
 private:
 	/**
 	 * Interface expected of a data function.
@@ -58,6 +64,7 @@ private:
 		virtual auto clone() -> std::unique_ptr<DataFunctionAbstract> = 0;
 		virtual auto before_reset(scip::Model& model) -> void = 0;
 		virtual auto extract(scip::Model& model, bool done) -> Data = 0;
+		virtual auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> Data = 0;
 	};
 
 	/**
@@ -72,6 +79,9 @@ private:
 		}
 		auto before_reset(scip::Model& model) -> void override { return m_data_function.before_reset(model); }
 		auto extract(scip::Model& model, bool done) -> Data override { return m_data_function.extract(model, done); }
+		auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> Data override {
+			return data::extract(m_data_function, model, done, context);
+		}
 
 		DataFunction m_data_function;
 	};
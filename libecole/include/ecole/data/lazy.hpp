@@ -0,0 +1,158 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/exception.hpp"
+#include "ecole/traits.hpp"
+
+namespace ecole::data {
+
+/**
+ * Handle to data extracted on first access.
+ *
+ * The data relates to the state of the model at the time the handle was created.
+ * The handle expires on the next transition (or reset) of the environment, after which accessing data that was not
+ * already extracted throws a MarkovError.
+ * Copies of the handle share the same data.
+ */
+template <typename Data> class Lazy {
+public:
+	Lazy() = default;
+
+	/** Create a handle calling the given function on first access. */
+	Lazy(std::function<Data()> extract_func) : state{std::make_shared<State>(std::move(extract_func))} {}
+
+	/** Create a handle on data that is already extracted. */
+	static auto from_data(Data data) -> Lazy {
+		auto handle = Lazy{std::function<Data()>{}};
+		handle.state->data = std::move(data);
+		return handle;
+	}
+
+	/** Extract the data if not already done, and return it. */
+	auto get() -> Data& {
+		if (!state) {
+			throw MarkovError{"Lazy data accessed without being extracted."};
+		}
+		auto const lk = std::lock_guard{state->mutex};
+		if (!state->data.has_value()) {
+			if (!state->extract_func) {
+				throw MarkovError{"Lazy data accessed after the state it relates to has changed."};
+			}
+			state->data = state->extract_func();
+			state->extract_func = nullptr;
+		}
+		return state->data.value();
+	}
+
+	/** Whether the data was already extracted. */
+	[[nodiscard]] auto extracted() const -> bool {
+		if (!state) {
+			return false;
+		}
+		auto const lk = std::lock_guard{state->mutex};
+		return state->data.has_value();
+	}
+
+	/** Whether the data can no longer be extracted. */
+	[[nodiscard]] auto expired() const -> bool {
+		if (!state) {
+			return true;
+		}
+		auto const lk = std::lock_guard{state->mutex};
+		return !state->data.has_value() && !state->extract_func;
+	}
+
+	/** Prevent any later extraction, waiting for an ongoing one to finish. */
+	auto expire() -> void {
+		if (state) {
+			auto const lk = std::lock_guard{state->mutex};
+			state->extract_func = nullptr;
+		}
+	}
+
+private:
+	struct State {
+		State(std::function<Data()> func) : extract_func{std::move(func)} {}
+
+		std::mutex mutex;
+		std::function<Data()> extract_func;
+		std::optional<Data> data;
+	};
+
+	std::shared_ptr<State> state;
+};
+
+/**
+ * Defer the extraction of a function until its data is accessed.
+ *
+ * Extract a Lazy handle rather than the data itself, so that no work is done for data that is never used.
+ * The previous handle expires on before_reset and before_transition, which the environment calls before changing the
+ * state of the model.
+ * The first extraction after before_reset is eager, because functions such as Khalil2016 compute on the root node
+ * static data that their later extractions rely on.
+ * The wrapped function does not share the StepContext of the environment, which the handle could outlive.
+ */
+template <typename Function> class LazyFunction {
+public:
+	using Data = trait::data_of_t<Function>;
+
+	LazyFunction() = default;
+	LazyFunction(Function func_) : func{std::make_shared<Function>(std::move(func_))} {}
+
+	/** Copies do not share the wrapped function, nor the last handle. */
+	LazyFunction(LazyFunction const& other) : func{copy_func(other)}, eager{other.eager} {}
+	LazyFunction(LazyFunction&&) noexcept = default;
+	LazyFunction& operator=(LazyFunction const& other) {
+		if (this != &other) {
+			last_handle.expire();
+			func = copy_func(other);
+			eager = other.eager;
+			last_handle = {};
+		}
+		return *this;
+	}
+	LazyFunction& operator=(LazyFunction&&) noexcept = default;
+	~LazyFunction() = default;
+
+	/** Expire the last handle and reset the wrapped function. */
+	auto before_reset(scip::Model& model) -> void {
+		last_handle.expire();
+		func->before_reset(model);
+		eager = true;
+	}
+
+	/** Expire the last handle before the model changes state. */
+	auto before_transition(scip::Model& /* model */) -> void { last_handle.expire(); }
+
+	/** Return a handle extracting the data of the wrapped function on first access (or now, after a reset). */
+	auto extract(scip::Model& model, bool done) -> Lazy<Data> {
+		last_handle.expire();
+		if (eager) {
+			eager = false;
+			last_handle = Lazy<Data>::from_data(func->extract(model, done));
+		} else {
+			// The wrapped function is shared so that the handle remains valid if this function is moved.
+			last_handle = Lazy<Data>{[func_ = func, &model, done]() { return func_->extract(model, done); }};
+		}
+		return last_handle;
+	}
+
+private:
+	std::shared_ptr<Function> func = std::make_shared<Function>();
+	Lazy<Data> last_handle;
+	/** Whether the next extraction is the first one after a reset. */
+	bool eager = true;
+
+	/** Moved-from functions have no wrapped function to copy. */
+	static auto copy_func(LazyFunction const& other) -> std::shared_ptr<Function> {
+		return other.func ? std::make_shared<Function>(*other.func) : nullptr;
+	}
+};
+
+}  // namespace ecole::data
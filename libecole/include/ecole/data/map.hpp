@@ -1,18 +1,30 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/concurrent.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/traits.hpp"
 
 namespace ecole::data {
 
-/** Combine multiple data into a map of data. */
+/**
+ * Combine multiple data into a map of data.
+ *
+ * Read-only functions are extracted concurrently.
+ */
 template <typename Key, typename Function> class MapFunction {
 public:
 	using DataMap = std::map<Key, trait::data_of_t<Function>>;
 
+	static inline constexpr bool read_only = trait::is_read_only_function_v<Function>;
+
 	/** Default construct all functions. */
 	MapFunction() = default;
 
@@ -26,17 +38,52 @@ public:
 		}
 	}
 
-	/** Return data extracted from all functions as a map. */
+	/** Return data extracted from all functions as a map, sharing a new context between them. */
 	DataMap extract(scip::Model& model, bool done) {
+		auto context = StepContext{};
+		return extract_in_context(model, done, context);
+	}
+
+	/** Return data extracted from all functions as a map, sharing the given context between them. */
+	DataMap extract_in_context(scip::Model& model, bool done, StepContext& context) {
+		if constexpr (read_only) {
+			if (data_functions.size() > 1) {
+				return extract_concurrently(model, done, context);
+			}
+		}
 		auto data = DataMap{};
 		for (auto& [key, func] : data_functions) {
-			data.emplace_hint(data.end(), key, func.extract(model, done));
+			data.emplace_hint(data.end(), key, data::extract(func, model, done, context));
 		}
 		return data;
 	}
 
 private:
 	std::map<Key, Function> data_functions;
+
+	DataMap extract_concurrently(scip::Model& model, bool done, StepContext& context) {
+		auto const concurrent = context.prepare_concurrent_reads(model);
+		auto results = std::vector<std::optional<trait::data_of_t<Function>>>(data_functions.size());
+		auto tasks = std::vector<std::function<void()>>{};
+		tasks.reserve(data_functions.size());
+		for (auto& [_, func] : data_functions) {
+			tasks.emplace_back([&result = results[tasks.size()], &func = func, &model, done, &context] {
+				result = data::extract(func, model, done, context);
+			});
+		}
+		if (concurrent) {
+			internal::run_concurrently(tasks);
+		} else {
+			internal::run_sequentially(tasks);
+		}
+
+		auto data = DataMap{};
+		auto result = results.begin();
+		for (auto const& [key, _] : data_functions) {
+			data.emplace_hint(data.end(), key, std::move(*result++).value());
+		}
+		return data;
+	}
 };
 
 }  // namespace ecole::data
@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/traits.hpp"
 
 namespace ecole::data {
@@ -33,8 +34,15 @@ public:
 
 	/** Extract data from all functions and call the multiart operation on it. */
 	auto extract(scip::Model& model, bool done = false) -> CombinedData {
+		auto context = StepContext{};
+		return extract_in_context(model, done, context);
+	}
+
+	/** Same as extract, sharing the given context between all functions. */
+	auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> CombinedData {
 		return std::apply(
-			[&](auto&... functions) { return data_combiner(functions.extract(model, done)...); }, data_functions);
+			[&](auto&... functions) { return data_combiner(data::extract(functions, model, done, context)...); },
+			data_functions);
 	}
 
 private:
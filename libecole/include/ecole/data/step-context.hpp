@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/export.hpp"
+#include "ecole/traits.hpp"
+
+namespace ecole::data {
+
+/**
+ * Quantities of the current state of the model shared by all data functions extracted on it.
+ *
+ * Observation, reward, and information functions often query the same data from SCIP, such as the branching
+ * candidates or the norms of the LP rows.
+ * The context computes each of them on first access, and memoizes it until it is invalidated.
+ * The environment owns a context that it invalidates before every transition (and reset), and passes it to the data
+ * functions that have an ``extract_in_context`` method.
+ *
+ * Accessors can be called concurrently (for instance by read-only functions in a TupleFunction), but not
+ * concurrently with invalidate.
+ * Many SCIP getters are not safe to call concurrently, because SCIP computes some quantities lazily and caches them
+ * in the model, so prepare_concurrent_reads must be called on a single thread before extracting concurrently, and
+ * extraction must run on a single thread if it returns false.
+ */
+class ECOLE_EXPORT StepContext {
+public:
+	/** Branching candidates, with their problem index (``SCIPvarGetProbindex``). */
+	struct BranchCands {
+		std::vector<SCIP_VAR*> variables;
+		/** Value of the candidates in the LP solution, only for LP branching candidates. */
+		std::vector<SCIP_Real> lp_values;
+		xt::xtensor<std::size_t, 1> indices;
+	};
+
+	ECOLE_EXPORT StepContext();
+	ECOLE_EXPORT StepContext(StepContext&& /*other*/) noexcept;
+	ECOLE_EXPORT StepContext& operator=(StepContext&& /*other*/) noexcept;
+	ECOLE_EXPORT ~StepContext();
+
+	/** Forget all memoized quantities, to be called before the state of the model changes. */
+	ECOLE_EXPORT auto invalidate() -> void;
+
+	/**
+	 * Compute the quantities that SCIP caches lazily, so that read-only functions can then query them concurrently.
+	 *
+	 * These are the memoized quantities of this context, the objective norm (``SCIPgetObjNorm``), and, when the LP of
+	 * the current node is solved, the reduced costs of the LP columns and the activities of the LP rows.
+	 *
+	 * @return Whether reads can run concurrently, which is only the case during solving with the LP of the current
+	 *         node solved to optimality.
+	 *         Otherwise, some quantities could not be computed beforehand and functions must be extracted in order.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto prepare_concurrent_reads(scip::Model& model) -> bool;
+
+	/** Number of LPs solved so far (``SCIPgetNLPs``). */
+	[[nodiscard]] ECOLE_EXPORT auto n_lps(scip::Model& model) -> SCIP_Longint;
+
+	/** Euclidean norm of the objective (``SCIPgetObjNorm``). */
+	[[nodiscard]] ECOLE_EXPORT auto obj_norm(scip::Model& model) -> SCIP_Real;
+
+	/** Euclidean norm of each LP row (``SCIProwGetNorm``), in the order of ``Model::lp_rows``. */
+	[[nodiscard]] ECOLE_EXPORT auto lp_row_norms(scip::Model& model) -> nonstd::span<SCIP_Real const>;
+
+	/** LP branching candidates, in the order of ``SCIPgetLPBranchCands``. */
+	[[nodiscard]] ECOLE_EXPORT auto lp_branch_cands(scip::Model& model) -> BranchCands const&;
+
+	/** Pseudo branching candidates, in the order of ``SCIPgetPseudoBranchCands``, without LP values. */
+	[[nodiscard]] ECOLE_EXPORT auto pseudo_branch_cands(scip::Model& model) -> BranchCands const&;
+
+private:
+	struct Memo;
+	std::unique_ptr<Memo> memo;
+};
+
+/**
+ * Extract the data of a function, sharing the context with it if it has an ``extract_in_context`` method.
+ */
+template <typename Function>
+auto extract(Function& func, scip::Model& model, bool done, StepContext& context) -> trait::data_of_t<Function> {
+	if constexpr (trait::internal::has_extract_in_context_v<Function>) {
+		return func.extract_in_context(model, done, context);
+	} else {
+		return func.extract(model, done);
+	}
+}
+
+}  // namespace ecole::data
@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/utility/chrono.hpp"
 
 namespace ecole::data {
@@ -40,6 +41,15 @@ public:
 		return internal::time<utility::cpu_clock>([&]() { return func.extract(model, done); });
 	}
 
+	/** Time the extraction of the function in the given context, excluding what others already memoized in it. **/
+	auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> double {
+		auto const extract_func = [&]() { return data::extract(func, model, done, context); };
+		if (wall) {
+			return internal::time<std::chrono::steady_clock>(extract_func);
+		}
+		return internal::time<utility::cpu_clock>(extract_func);
+	}
+
 private:
 	Function func{};
 	bool wall = false;
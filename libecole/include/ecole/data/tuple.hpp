@@ -1,16 +1,30 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <optional>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/concurrent.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/traits.hpp"
 
 namespace ecole::data {
 
+/**
+ * Combine multiple data into a tuple of data.
+ *
+ * Consecutive read-only functions are extracted concurrently, other functions are extracted in order on their own.
+ */
 template <typename... Functions> class TupleFunction {
 public:
 	using DataTuple = std::tuple<trait::data_of_t<Functions>...>;
 
+	static inline constexpr bool read_only = (trait::is_read_only_function_v<Functions> && ...);
+
 	/** Default construct all functions. */
 	TupleFunction() = default;
 
@@ -23,14 +37,41 @@ public:
 		std::apply([&model](auto&... functions) { ((functions.before_reset(model)), ...); }, data_functions);
 	}
 
-	/** Return data from all functions as a tuple. */
+	/** Return data from all functions as a tuple, sharing a new context between them. */
 	auto extract(scip::Model& model, bool done) -> DataTuple {
-		return std::apply(
-			[&model, done](auto&... functions) { return std::tuple{functions.extract(model, done)...}; }, data_functions);
+		auto context = StepContext{};
+		return extract_in_context(model, done, context);
+	}
+
+	/** Return data from all functions as a tuple, sharing the given context between them. */
+	auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> DataTuple {
+		if constexpr ((static_cast<std::size_t>(trait::is_read_only_function_v<Functions>) + ... + 0) > 1) {
+			return extract_concurrently(model, done, context, std::index_sequence_for<Functions...>{});
+		} else {
+			return std::apply(
+				[&](auto&... functions) { return std::tuple{data::extract(functions, model, done, context)...}; },
+				data_functions);
+		}
 	}
 
 private:
 	std::tuple<Functions...> data_functions;
+
+	template <std::size_t... I>
+	auto extract_concurrently(
+		scip::Model& model,
+		bool done,
+		StepContext& context,
+		std::index_sequence<I...> /*indices*/) -> DataTuple {
+		auto results = std::tuple<std::optional<trait::data_of_t<Functions>>...>{};
+		auto tasks = std::vector<std::function<void()>>{
+			[&] { std::get<I>(results) = data::extract(std::get<I>(data_functions), model, done, context); }...};
+		internal::run_read_only_concurrently(
+			std::move(tasks), {trait::is_read_only_function_v<Functions>...}, [&] {
+				return context.prepare_concurrent_reads(model);
+			});
+		return {std::move(std::get<I>(results)).value()...};
+	}
 };
 
 }  // namespace ecole::data
@@ -1,20 +1,31 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/data/concurrent.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/traits.hpp"
 
 namespace ecole::data {
 
-/* Combine multiple data into a vector of data. */
+/**
+ * Combine multiple data into a vector of data.
+ *
+ * Read-only functions are extracted concurrently.
+ */
 template <typename Function> class VectorFunction {
 public:
 	using DataVector = std::vector<trait::data_of_t<Function>>;
 
+	static inline constexpr bool read_only = trait::is_read_only_function_v<Function>;
+
 	/** Default construct all functions. */
 	VectorFunction() = default;
 
@@ -28,18 +39,53 @@ public:
 		}
 	}
 
-	/** Return data extracted from all functions as a vector. */
+	/** Return data extracted from all functions as a vector, sharing a new context between them. */
 	auto extract(scip::Model& model, bool done) -> DataVector {
+		auto context = StepContext{};
+		return extract_in_context(model, done, context);
+	}
+
+	/** Return data extracted from all functions as a vector, sharing the given context between them. */
+	auto extract_in_context(scip::Model& model, bool done, StepContext& context) -> DataVector {
+		if constexpr (read_only) {
+			if (data_functions.size() > 1) {
+				return extract_concurrently(model, done, context);
+			}
+		}
 		auto data = DataVector{};
 		data.reserve(data_functions.size());
-		std::transform(data_functions.begin(), data_functions.end(), std::back_inserter(data), [&model, done](auto& func) {
-			return func.extract(model, done);
+		std::transform(data_functions.begin(), data_functions.end(), std::back_inserter(data), [&](auto& func) {
+			return data::extract(func, model, done, context);
 		});
 		return data;
 	}
 
 private:
 	std::vector<Function> data_functions;
+
+	auto extract_concurrently(scip::Model& model, bool done, StepContext& context) -> DataVector {
+		auto const concurrent = context.prepare_concurrent_reads(model);
+		auto results = std::vector<std::optional<trait::data_of_t<Function>>>(data_functions.size());
+		auto tasks = std::vector<std::function<void()>>{};
+		tasks.reserve(data_functions.size());
+		for (std::size_t i = 0; i < data_functions.size(); ++i) {
+			tasks.emplace_back([&, i] { results[i] = data::extract(data_functions[i], model, done, context); });
+		}
+		if (concurrent) {
+			internal::run_concurrently(tasks);
+		} else {
+			internal::run_sequentially(tasks);
+		}
+
+		auto data = DataVector{};
+		data.reserve(results.size());
+		std::transform(
+			std::move_iterator{results.begin()},
+			std::move_iterator{results.end()},
+			std::back_inserter(data),
+			[](auto&& result) { return std::move(result).value(); });
+		return data;
+	}
 };
 
 }  // namespace ecole::data
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <optional>
 
 #include <xtensor/xtensor.hpp>
@@ -15,6 +16,8 @@ class ECOLE_EXPORT BranchingDynamics : public DefaultSetDynamicsRandomState {
 public:
 	using Action = Defaultable<std::size_t>;
 	using ActionSet = std::optional<xt::xtensor<std::size_t, 1>>;
+	/** Policy used in direct mode, returning the action to take given the model and the action set. */
+	using Policy = std::function<Action(scip::Model&, ActionSet const&)>;
 
 	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
 
@@ -24,6 +27,14 @@ public:
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_var_idx) const -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Solve the model, calling the policy synchronously from within SCIP on every branching decision.
+	 *
+	 * Equivalent to ``reset_dynamics`` followed by ``step_dynamics`` with the actions returned by the policy, but
+	 * without ever pausing the solver.
+	 */
+	ECOLE_EXPORT auto solve_with_policy(scip::Model& model, Policy const& policy) const -> void;
+
 private:
 	bool pseudo_candidates;
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <scip/type_result.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/default.hpp"
+#include "ecole/dynamics/parts.hpp"
+#include "ecole/export.hpp"
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+
+namespace ecole::dynamics {
+
+/** Branching candidates of a node with their strong branching evaluation. */
+struct ECOLE_EXPORT ExpertBranchingActionSet {
+	/** Index (``SCIPvarGetProbindex``) of each branching candidate, by decreasing pseudocost score. */
+	xt::xtensor<std::size_t, 1> candidates;
+	/** Strong branching score of each candidate, estimated from the pseudocosts when not evaluated. */
+	xt::xtensor<double, 1> scores;
+	/** Whether the score of each candidate was computed by strong branching to optimality. */
+	xt::xtensor<bool, 1> exact;
+	/** Index (``SCIPvarGetProbindex``) of the candidate with the best score, the expert decision. */
+	std::size_t expert_action = 0;
+};
+
+/**
+ * Single variable branching with a strong branching expert.
+ *
+ * Like BranchingDynamics, but strong branching is done on the candidates every time the solver pauses, and the
+ * result given in the action set.
+ * When stepping, in the same branching callback, the decision reuses the strong branching work rather than having
+ * SCIP solve the children again: the domain reductions found are applied, and the dual bound of the children is set
+ * from strong branching.
+ */
+class ECOLE_EXPORT ExpertBranchingDynamics : public DefaultSetDynamicsRandomState {
+public:
+	/** The variable to branch on, the expert decision by default. */
+	using Action = Defaultable<std::size_t>;
+	using ActionSet = std::optional<ExpertBranchingActionSet>;
+	/** Policy used in direct mode, returning the action to take given the model and the action set. */
+	using Policy = std::function<Action(scip::Model&, ActionSet const&)>;
+
+	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
+
+	/** Create the dynamics, with the same strong branching budget as BudgetedStrongBranchingScores. */
+	ECOLE_EXPORT ExpertBranchingDynamics(
+		bool pseudo_candidates = false,
+		std::optional<int> iteration_limit = {},
+		std::optional<double> time_limit = {},
+		std::optional<std::size_t> top_k = {},
+		std::size_t n_threads = 0);
+
+	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) -> std::tuple<bool, ActionSet>;
+
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_var_idx) -> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Solve the model, calling the policy synchronously from within SCIP on every branching decision.
+	 *
+	 * Equivalent to ``reset_dynamics`` followed by ``step_dynamics`` with the actions returned by the policy, but
+	 * without ever pausing the solver.
+	 */
+	ECOLE_EXPORT auto solve_with_policy(scip::Model& model, Policy const& policy) -> void;
+
+private:
+	observation::BudgetedStrongBranchingScores expert;
+	/** Strong branching evaluation of the node where the solver is paused. */
+	std::vector<observation::StrongBranchingCandidate> evaluation;
+
+	auto action_set(scip::Model& model) -> ActionSet;
+	auto branch(scip::Model& model, Action maybe_var_idx) -> SCIP_RESULT;
+};
+
+}  // namespace ecole::dynamics
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <optional>
 
 #include <scip/scip_tree.h>
@@ -21,6 +22,8 @@ public:
 	using Action = Defaultable<std::size_t>;
 	using ActionSet =
 		std::optional<std::tuple<xt::xtensor<std::size_t, 1>, xt::xtensor<std::size_t, 1>, xt::xtensor<std::size_t, 1>>>;
+	/** Policy used in direct mode, returning the action to take given the model and the action set. */
+	using Policy = std::function<Action(scip::Model&, ActionSet const&)>;
 
 	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
 
@@ -28,8 +31,17 @@ public:
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_node_idx) -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Solve the model, calling the policy synchronously from within SCIP on every node selection.
+	 *
+	 * Equivalent to ``reset_dynamics`` followed by ``step_dynamics`` with the actions returned by the policy, but
+	 * without ever pausing the solver.
+	 */
+	ECOLE_EXPORT auto solve_with_policy(scip::Model& model, Policy const& policy) -> void;
+
 private:
 	auto action_set(scip::Model const& model) -> ActionSet;
+	auto select_node(Action maybe_node_idx) -> SCIP_RESULT;
 
 	// stores the pointer to the selected node variable
 	scip::callback::NodeselCall fcall;
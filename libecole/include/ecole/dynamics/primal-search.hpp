@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -20,6 +21,12 @@ public:
 	using ActionSet = std::optional<xt::xtensor<std::size_t, 1>>;
 	/** A tuple of variable identifiers and variable values. */
 	using Action = std::pair<nonstd::span<std::size_t const>, nonstd::span<SCIP_Real const>>;
+	/**
+	 * Policy used in direct mode, returning the action to take given the model and the action set.
+	 *
+	 * The spans in the returned action must remain valid until the policy is called again.
+	 */
+	using Policy = std::function<Action(scip::Model&, ActionSet const&)>;
 
 	ECOLE_EXPORT
 	PrimalSearchDynamics(int trials_per_node = 1, int depth_freq = 1, int depth_start = 0, int depth_stop = -1);
@@ -30,6 +37,14 @@ public:
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action action) -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Solve the model, calling the policy synchronously from within SCIP on every search trial.
+	 *
+	 * Equivalent to ``reset_dynamics`` followed by ``step_dynamics`` with the actions returned by the policy, but
+	 * without ever pausing the solver.
+	 */
+	ECOLE_EXPORT auto solve_with_policy(scip::Model& model, Policy const& policy) const -> void;
+
 private:
 	int trials_per_node;
 	int depth_freq;
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <limits>
 #include <map>
+#include <memory>
 #include <random>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "ecole/data/parser.hpp"
+#include "ecole/data/step-context.hpp"
+#include "ecole/environment/presolved-cache.hpp"
 #include "ecole/exception.hpp"
 #include "ecole/information/abstract.hpp"
 #include "ecole/random.hpp"
@@ -13,6 +24,8 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/seed.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/coroutine.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 #include <optional>
 
@@ -35,8 +48,12 @@ namespace ecole::environment {
  *         environment
  * @tparam ObservationFunction The ecole::observation::ObservationFunction to extract an observation out of the
  *         current state.
+ *         Wrap it in an ecole::data::LazyFunction to only extract observations that are accessed.
  * @tparam RewardFunction The ecole::reward::RewardFunction to extract the reward of the last transition.
  * @tparam InformationFunction The ecole::information::InformationFunction to extract additional informations.
+ *
+ * Data functions with an ``extract_in_context`` method share a data::StepContext, so that quantities queried by
+ * several of them are only computed once per state.
  */
 template <typename Dynamics, typename ObservationFunction, typename RewardFunction, typename InformationFunction>
 class Environment {
@@ -72,6 +89,53 @@ public:
 		the_scip_params(std::move(scip_params)),
 		the_rng(spawn_random_generator()) {}
 
+	/**
+	 * Move an environment without pending asynchronous step.
+	 *
+	 * @throw MarkovError If an asynchronous step is pending, since it refers to the moved environment.
+	 */
+	Environment(Environment&& other) :
+		the_dynamics((other.throw_if_step_pending(), std::move(other.the_dynamics))),
+		the_model(std::move(other.the_model)),
+		the_reward_function(std::move(other.the_reward_function)),
+		the_observation_function(std::move(other.the_observation_function)),
+		the_information_function(std::move(other.the_information_function)),
+		the_scip_params(std::move(other.the_scip_params)),
+		the_rng(std::move(other.the_rng)),
+		the_presolved_cache(std::move(other.the_presolved_cache)),
+		the_step_context(std::move(other.the_step_context)),
+		can_transition(other.can_transition) {}
+
+	/**
+	 * Move assign an environment, when neither has a pending asynchronous step.
+	 *
+	 * @throw MarkovError If an asynchronous step is pending on either environment.
+	 */
+	Environment& operator=(Environment&& other) {
+		throw_if_step_pending();
+		other.throw_if_step_pending();
+		the_dynamics = std::move(other.the_dynamics);
+		the_model = std::move(other.the_model);
+		the_reward_function = std::move(other.the_reward_function);
+		the_observation_function = std::move(other.the_observation_function);
+		the_information_function = std::move(other.the_information_function);
+		the_scip_params = std::move(other.the_scip_params);
+		the_rng = std::move(other.the_rng);
+		the_presolved_cache = std::move(other.the_presolved_cache);
+		the_step_context = std::move(other.the_step_context);
+		can_transition = other.can_transition;
+		return *this;
+	}
+
+	/**
+	 * Wait for any pending asynchronous step before destroying the environment.
+	 */
+	~Environment() {
+		if (pending_step.valid()) {
+			pending_step.wait();
+		}
+	}
+
 	/**
 	 * Set the random seed for the environment, hence making its internals deterministic.
 	 *
@@ -103,17 +167,10 @@ public:
 	template <typename... Args>
 	auto reset(scip::Model&& new_model, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		throw_if_step_pending();
 		can_transition = true;
 		try {
-			// Create clean new Model
-			model() = std::move(new_model);
-			model().set_params(scip_params());
-			dynamics().set_dynamics_random_state(model(), rng());
-
-			// Reset data extraction function and bring model to initial state.
-			reward_function().before_reset(model());
-			observation_function().before_reset(model());
-			information_function().before_reset(model());
+			prepare_model(std::move(new_model));
 
 			// Place the environment in its initial state
 			auto [done, action_set] = dynamics().reset_dynamics(model(), std::forward<Args>(args)...);
@@ -141,12 +198,99 @@ public:
 		return reset(model.copy_orig(), std::forward<Args>(args)...);
 	}
 
+	/**
+	 * Reset the environment on the problem instance read from the given file.
+	 *
+	 * If a PresolvedCache is set, the instance is instead copied from its presolved template, and the duration of the
+	 * reset is recorded in the cache statistics.
+	 * The variables of the presolved instance do not have the same indices as the ones in the file.
+	 */
 	template <typename... Args>
 	auto reset(std::string const& filename, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		if (presolved_cache() != nullptr) {
+			auto const start = std::chrono::steady_clock::now();
+			auto [model, hit] = presolved_cache()->lookup(filename, scip_params());
+			auto result = reset(std::move(model), std::forward<Args>(args)...);
+			auto const elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+			presolved_cache()->record_reset(hit, elapsed);
+			return result;
+		}
 		return reset(scip::Model::from_file(filename), std::forward<Args>(args)...);
 	}
 
+	/**
+	 * Reset the environment and fast-forward it through a sequence of actions.
+	 *
+	 * Same as a reset followed by calls to step with the first ``n_actions`` actions, but only the final state is
+	 * extracted.
+	 * The observation of the initial state is still extracted (and discarded) since some observation functions
+	 * compute data on the root node that they reuse later on.
+	 * The returned reward is the one accumulated over all the replayed transitions for reward functions that are
+	 * computed as a difference between states.
+	 * The replay stops early if a terminal state is reached.
+	 *
+	 * @param new_model Passed to the EnvironmentDynamics to start a new trajectory.
+	 * @param actions A recorded sequence of actions, for instance of a previous episode on the same instance.
+	 * @param n_actions The number of actions to replay, all of them if larger than the number of actions.
+	 * @return The same as reset, but in the state reached after the replayed actions.
+	 */
+	auto replay(
+		scip::Model&& new_model,
+		std::vector<Action> const& actions,
+		std::size_t n_actions = std::numeric_limits<std::size_t>::max())
+		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		throw_if_step_pending();
+		can_transition = true;
+		try {
+			prepare_model(std::move(new_model));
+
+			auto [done, action_set] = dynamics().reset_dynamics(model());
+			if (!done) {
+				[[maybe_unused]] auto const initial_observation =
+					data::extract(observation_function(), model(), done, step_context());
+			}
+			auto const end = std::min(n_actions, actions.size());
+			for (std::size_t i = 0; (i < end) && !done; ++i) {
+				notify_before_transition();
+				std::tie(done, action_set) = dynamics().step_dynamics(model(), actions[i]);
+			}
+			can_transition = !done;
+
+			auto [reward, observation, information] = extract_reward_observation_information(done);
+
+			return {
+				std::move(observation),
+				std::move(action_set),
+				std::move(reward),
+				done,
+				std::move(information),
+			};
+		} catch (std::exception const&) {
+			can_transition = false;
+			throw;
+		}
+	}
+
+	auto replay(
+		scip::Model const& model,
+		std::vector<Action> const& actions,
+		std::size_t n_actions = std::numeric_limits<std::size_t>::max())
+		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		return replay(model.copy_orig(), actions, n_actions);
+	}
+
+	auto replay(
+		std::string const& filename,
+		std::vector<Action> const& actions,
+		std::size_t n_actions = std::numeric_limits<std::size_t>::max())
+		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		if (presolved_cache() != nullptr) {
+			return replay(presolved_cache()->get(filename, scip_params()), actions, n_actions);
+		}
+		return replay(scip::Model::from_file(filename), actions, n_actions);
+	}
+
 	/**
 	 * Transition from one state to another.
 	 *
@@ -166,28 +310,110 @@ public:
 	template <typename... Args>
 	auto step(Action const& action, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		throw_if_step_pending();
+		return step_now(action, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Same as step, but write the observation in the given one rather than returning it.
+	 *
+	 * Observation functions with an ``extract_into`` method reuse the memory of the given observation, so that
+	 * transitions where the observation keeps the same size do not allocate it again.
+	 *
+	 * @param observation The observation of the previous state, overwritten with the one of the new state.
+	 * @return The same as step, except the observation.
+	 */
+	template <typename... Args>
+	auto step_into(OptionalObservation& observation, Action const& action, Args&&... args)
+		-> std::tuple<ActionSet, Reward, bool, InformationMap> {
+		throw_if_step_pending();
+		return step_now_into(observation, action, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Start a transition in the background and return immediately.
+	 *
+	 * Same as step, but the transition runs on a thread of the process-wide ecole::utility::ThreadPool.
+	 * Its result is retrieved with step_wait, and poll tells whether it would block.
+	 * No other method may be called on the environment until step_wait has been called.
+	 * The arguments are copied so they need not outlive the call.
+	 *
+	 * @pre A call to reset must have been done prior to transitioning.
+	 * @pre No other asynchronous step is pending.
+	 * The environment cannot be moved until step_wait has been called.
+	 * @throw std::logic_error If the model uses the ``utility::CoroutineBackend::Context`` backend, which can only be
+	 *        resumed from the thread that reset the environment.
+	 */
+	template <typename... Args> void step_async(Action const& action, Args&&... args) {
+		throw_if_step_pending();
 		if (!can_transition) {
 			throw MarkovError{"Environment need to be reset."};
 		}
-		try {
-			// Transition the environment to the next state
-			auto [done, action_set] = dynamics().step_dynamics(model(), action, std::forward<Args>(args)...);
-			can_transition = !done;
-
-			// Extract additional information to be returned by step
-			auto [reward, observation, information] = extract_reward_observation_information(done);
+		if (model().coroutine_backend() == utility::CoroutineBackend::Context) {
+			throw std::logic_error{"Cannot step asynchronously with the context coroutine backend."};
+		}
+		pending_step = utility::ThreadPool::global().submit(
+			[this, action, args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+				step_result = std::apply(
+					[&](auto&&... step_args) { return step_now(action, std::move(step_args)...); }, std::move(args));
+			});
+	}
 
-			return {
-				std::move(observation),
-				std::move(action_set),
-				std::move(reward),
-				done,
-				std::move(information),
-			};
-		} catch (std::exception const&) {
-			can_transition = false;
-			throw;
+	/**
+	 * Wait for the pending asynchronous step and return its result.
+	 *
+	 * @return The same as step.
+	 * @throw MarkovError If no asynchronous step is pending.
+	 * Exceptions thrown during the transition are rethrown here.
+	 */
+	auto step_wait() -> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		if (!pending_step.valid()) {
+			throw MarkovError{"No asynchronous step is pending."};
 		}
+		// Moved out first so that the environment is usable again even if the step threw.
+		auto pending = std::move(pending_step);
+		pending.get();
+		auto result = std::move(step_result).value();
+		step_result.reset();
+		return result;
+	}
+
+	/**
+	 * Whether the pending asynchronous step is finished, so that step_wait returns without blocking.
+	 *
+	 * Return false if no asynchronous step is pending.
+	 */
+	[[nodiscard]] auto poll() const -> bool {
+		return pending_step.valid() && pending_step.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+	}
+
+	/**
+	 * Solve a problem instance with a policy called in place, from within SCIP (direct mode).
+	 *
+	 * Meant for deploying a trained policy.
+	 * Rather than pausing SCIP to give back control in step, the dynamics call the policy synchronously from their
+	 * reverse callback, with an observation extracted in place by the observation function.
+	 * Observations and actions are the same as with reset and step, but no reward or information is extracted.
+	 * The environment is left in a terminal state.
+	 *
+	 * @param new_model The problem instance to solve.
+	 * @param policy A callable taking an observation and an action set, and returning an action.
+	 */
+	template <typename Policy> void solve_with_policy(scip::Model&& new_model, Policy&& policy) {
+		throw_if_step_pending();
+		can_transition = false;
+		model() = std::move(new_model);
+		model().set_params(scip_params());
+		dynamics().set_dynamics_random_state(model(), rng());
+		observation_function().before_reset(model());
+		dynamics().solve_with_policy(model(), [&](scip::Model& the_model, ActionSet const& action_set) -> Action {
+			step_context().invalidate();
+			return policy(data::extract(observation_function(), the_model, false, step_context()), action_set);
+		});
+	}
+
+	template <typename Policy> void solve_with_policy(scip::Model const& model, Policy&& policy) {
+		solve_with_policy(model.copy_orig(), std::forward<Policy>(policy));
 	}
 
 	auto& dynamics() { return the_dynamics; }
@@ -197,6 +423,10 @@ public:
 	auto& information_function() { return the_information_function; }
 	auto& scip_params() { return the_scip_params; }
 	auto& rng() { return the_rng; }
+	/** Optional, possibly shared, cache of presolved instances used when resetting from a file. */
+	auto& presolved_cache() { return the_presolved_cache; }
+	/** Quantities of the current state shared by the data functions, invalidated on every transition. */
+	auto& step_context() { return the_step_context; }
 
 private:
 	Dynamics the_dynamics;
@@ -206,17 +436,108 @@ private:
 	InformationFunction the_information_function;
 	std::map<std::string, scip::Param> the_scip_params;
 	RandomGenerator the_rng;
+	std::shared_ptr<PresolvedCache> the_presolved_cache;
+	data::StepContext the_step_context;
 	bool can_transition = false;
+	std::future<void> pending_step;
+	std::optional<std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>> step_result;
+
+	// Create clean new Model and reset data extraction functions on it
+	void prepare_model(scip::Model&& new_model) {
+		step_context().invalidate();
+		model() = std::move(new_model);
+		model().set_params(scip_params());
+		dynamics().set_dynamics_random_state(model(), rng());
+
+		reward_function().before_reset(model());
+		observation_function().before_reset(model());
+		information_function().before_reset(model());
+	}
 
 	// extract reward, observation and information (in that order)
 	auto extract_reward_observation_information(bool done) -> std::tuple<Reward, OptionalObservation, InformationMap> {
-		auto reward = reward_function().extract(model(), done);
+		auto reward = data::extract(reward_function(), model(), done, step_context());
 		// Don't extract observations in final states
-		auto observation = done ? OptionalObservation{} : observation_function().extract(model(), done);
-		auto information = information_function().extract(model(), done);
+		auto observation =
+			done ? OptionalObservation{} : data::extract(observation_function(), model(), done, step_context());
+		auto information = data::extract(information_function(), model(), done, step_context());
 
 		return {std::move(reward), std::move(observation), std::move(information)};
 	}
+
+	// Transition without checking for a pending asynchronous step, used by both step and step_async.
+	template <typename... Args>
+	auto step_now(Action const& action, Args&&... args)
+		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
+		auto observation = OptionalObservation{};
+		auto [action_set, reward, done, information] = step_now_into(observation, action, std::forward<Args>(args)...);
+		return {
+			std::move(observation),
+			std::move(action_set),
+			std::move(reward),
+			done,
+			std::move(information),
+		};
+	}
+
+	template <typename... Args>
+	auto step_now_into(OptionalObservation& observation, Action const& action, Args&&... args)
+		-> std::tuple<ActionSet, Reward, bool, InformationMap> {
+		if (!can_transition) {
+			throw MarkovError{"Environment need to be reset."};
+		}
+		try {
+			notify_before_transition();
+
+			// Transition the environment to the next state
+			auto [done, action_set] = dynamics().step_dynamics(model(), action, std::forward<Args>(args)...);
+			can_transition = !done;
+
+			// Extract additional information to be returned by step, in the same order as in reset
+			auto reward = data::extract(reward_function(), model(), done, step_context());
+			extract_observation_into(done, observation);
+			auto information = data::extract(information_function(), model(), done, step_context());
+
+			return {std::move(action_set), std::move(reward), done, std::move(information)};
+		} catch (std::exception const&) {
+			can_transition = false;
+			throw;
+		}
+	}
+
+	// Reuse the memory of the given observation if the observation function supports it
+	void extract_observation_into(bool done, OptionalObservation& observation) {
+		// Don't extract observations in final states
+		if (done) {
+			observation.reset();
+		} else if constexpr (
+			trait::internal::has_extract_into_in_context_v<ObservationFunction> && is_optional_v<Observation>) {
+			observation_function().extract_into(model(), done, observation, step_context());
+		} else if constexpr (trait::internal::has_extract_into_v<ObservationFunction> && is_optional_v<Observation>) {
+			observation_function().extract_into(model(), done, observation);
+		} else {
+			observation = data::extract(observation_function(), model(), done, step_context());
+		}
+	}
+
+	// Let the data functions that need it (such as lazy ones) know that the state is about to change
+	void notify_before_transition() {
+		step_context().invalidate();
+		auto const notify = [this](auto& func) {
+			if constexpr (trait::internal::has_before_transition_v<std::decay_t<decltype(func)>>) {
+				func.before_transition(model());
+			}
+		};
+		notify(reward_function());
+		notify(observation_function());
+		notify(information_function());
+	}
+
+	void throw_if_step_pending() const {
+		if (pending_step.valid()) {
+			throw MarkovError{"An asynchronous step is pending, call step_wait first."};
+		}
+	}
 };
 
 }  // namespace ecole::environment
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/type.hpp"
+
+namespace ecole::environment {
+
+/**
+ * A cache of presolved problem instances to speed up resets on the same instance.
+ *
+ * On the first request of an instance with some SCIP parameters, the instance is read and presolved, and the
+ * presolved problem is kept as a template.
+ * Later requests return a copy of the template, whose original problem is the presolved one, so reading the file and
+ * presolving are not repeated.
+ * Since presolving only happens once, randomness in the presolving is the same for all copies.
+ *
+ * Templates are keyed by the file name, its size and modification time, and a hash of the parameters that may change
+ * the presolved problem (see is_presolve_param), so that a modified file is presolved again.
+ * The other parameters are only set on the copies.
+ *
+ * The variables and constraints of the copies are those of the presolved problem: they are fewer, and their indices
+ * (and names, for aggregated variables) do not match the ones of the problem in the file.
+ * Actions and observations indexed by variables are therefore not interchangeable with resets without the cache.
+ *
+ * The cache is thread safe and can be shared among environments.
+ */
+class ECOLE_EXPORT PresolvedCache {
+public:
+	/** Counters of cache usage. */
+	struct ECOLE_EXPORT Statistics {
+		/** Number of requests answered with an existing template. */
+		std::size_t n_hits = 0;
+		/** Number of requests that had to create a template. */
+		std::size_t n_misses = 0;
+		/** Number of environment resets recorded on hits and on misses. */
+		std::size_t n_hit_resets = 0;
+		std::size_t n_miss_resets = 0;
+		/** Total time in seconds of the environment resets recorded on hits. */
+		double hits_reset_time = 0.;
+		/** Total time in seconds of the environment resets recorded on misses, including presolving. */
+		double misses_reset_time = 0.;
+
+		[[nodiscard]] ECOLE_EXPORT auto hit_rate() const noexcept -> double;
+		/** Average time in seconds of a recorded environment reset. */
+		[[nodiscard]] ECOLE_EXPORT auto mean_reset_time() const noexcept -> double;
+	};
+
+	/** A copy of a template, and whether the template already existed. */
+	struct ECOLE_EXPORT Lookup {
+		scip::Model model;
+		bool hit;
+	};
+
+	/**
+	 * Create a cache holding at most the given number of templates.
+	 *
+	 * Templates are evicted in the order they were created.
+	 */
+	ECOLE_EXPORT PresolvedCache(std::size_t capacity = 64);
+
+	/** Return a copy of the presolved template of the instance, creating it if needed. */
+	[[nodiscard]] ECOLE_EXPORT auto get(std::string const& filename, std::map<std::string, scip::Param> const& params)
+		-> scip::Model;
+
+	/** Same as get, but also tell whether the template already existed. */
+	[[nodiscard]] ECOLE_EXPORT auto
+	lookup(std::string const& filename, std::map<std::string, scip::Param> const& params) -> Lookup;
+
+	/**
+	 * Record the duration of an environment reset done on a copy from the cache.
+	 *
+	 * Lookups alone are fast on hits, this measures the time saved on the whole reset.
+	 */
+	ECOLE_EXPORT auto record_reset(bool hit, double seconds) -> void;
+
+	/**
+	 * Whether a SCIP parameter may change the presolved problem, and is thus part of the template key.
+	 *
+	 * These are the parameters of the reader, presolvers, propagators, constraint handlers, numerics, limits, random
+	 * seeds, and miscellaneous options.
+	 */
+	[[nodiscard]] ECOLE_EXPORT static auto is_presolve_param(std::string const& name) -> bool;
+
+	[[nodiscard]] ECOLE_EXPORT auto statistics() const -> Statistics;
+	[[nodiscard]] ECOLE_EXPORT auto size() const -> std::size_t;
+	[[nodiscard]] ECOLE_EXPORT auto capacity() const noexcept -> std::size_t { return m_capacity; }
+
+	/** Remove all templates, statistics are kept. */
+	ECOLE_EXPORT auto clear() -> void;
+
+private:
+	struct Key {
+		std::string filename;
+		std::uintmax_t file_size;
+		std::filesystem::file_time_type modification_time;
+		/** Hash of the parameters, compared before them since it is cheaper. */
+		std::size_t params_hash;
+		/** Parameters that may change the presolved problem, compared exactly so that hash collisions are harmless. */
+		std::map<std::string, scip::Param> params;
+
+		[[nodiscard]] auto operator<(Key const& other) const noexcept -> bool;
+	};
+
+	/** A model that is only ever copied. */
+	struct Template {
+		scip::Model model;
+		bool presolved;
+	};
+
+	mutable std::mutex m_mutex;
+	std::map<Key, std::shared_ptr<Template const>> m_templates;
+	std::deque<Key> m_insertion_order;
+	Statistics m_statistics;
+	std::size_t m_capacity;
+
+	static auto make_key(std::string const& filename, std::map<std::string, scip::Param> const& params) -> Key;
+	static auto make_template(std::string const& filename, std::map<std::string, scip::Param> const& params)
+		-> std::shared_ptr<Template const>;
+	static auto copy_template(Template const& the_template) -> scip::Model;
+};
+
+}  // namespace ecole::environment
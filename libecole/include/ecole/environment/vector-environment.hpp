@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ecole/environment/environment.hpp"
+#include "ecole/exception.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/random.hpp"
+#include "ecole/utility/coroutine.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::environment {
+
+/**
+ * Batch of environments stepped concurrently.
+ *
+ * The environments are stepped on a pool of worker threads, each worker being in charge of a fixed subset of the
+ * environments.
+ * Episodes are automatically restarted: when an environment reaches a terminal state, it is immediately reset on a
+ * new instance drawn from the instance generator.
+ * In that case, the returned done flag and reward are those of the terminal transition, while the observation and
+ * action set are those of the initial state of the new episode.
+ *
+ * @tparam Dynamics The ecole::environment::EnvironmentDynamics of each environment.
+ * @tparam ObservationFunction The ecole::observation::ObservationFunction of each environment.
+ * @tparam RewardFunction The ecole::reward::RewardFunction of each environment.
+ * @tparam InformationFunction The ecole::information::InformationFunction of each environment.
+ */
+template <typename Dynamics, typename ObservationFunction, typename RewardFunction, typename InformationFunction>
+class VectorEnvironment {
+public:
+	using Env = Environment<Dynamics, ObservationFunction, RewardFunction, InformationFunction>;
+	using Seed = typename Env::Seed;
+	using OptionalObservation = typename Env::OptionalObservation;
+	using Action = typename Env::Action;
+	using ActionSet = typename Env::ActionSet;
+	using Reward = typename Env::Reward;
+	using InformationMap = typename Env::InformationMap;
+	/** Default number of instances drawn for an environment in a single reset. */
+	static inline constexpr std::size_t default_max_reset_trials = 100;
+
+	using Batch = std::tuple<
+		std::vector<OptionalObservation>,
+		std::vector<ActionSet>,
+		std::vector<Reward>,
+		std::vector<bool>,
+		std::vector<InformationMap>>;
+
+	/**
+	 * Batch the given environments.
+	 *
+	 * @param envs The environments to step concurrently.
+	 * @param instance_generator The generator used to draw the instances on which environments are reset.
+	 * @param n_workers The number of worker threads, by default the hardware concurrency.
+	 * @param max_reset_trials The number of instances drawn for an environment, in a single reset, before giving up
+	 *        if all of them are solved during the reset.
+	 */
+	VectorEnvironment(
+		std::vector<Env> envs,
+		std::shared_ptr<instance::InstanceGenerator> instance_generator,
+		std::size_t n_workers = 0,
+		std::size_t max_reset_trials = default_max_reset_trials) :
+		the_envs(std::move(envs)),
+		the_instance_generator(std::move(instance_generator)),
+		the_n_workers(n_workers > 0 ? n_workers : std::max<std::size_t>(std::thread::hardware_concurrency(), 1)),
+		the_max_reset_trials(std::max<std::size_t>(max_reset_trials, 1)) {
+		the_n_workers = std::max<std::size_t>(std::min(the_n_workers, the_envs.size()), 1);
+		if (the_instance_generator == nullptr) {
+			throw std::invalid_argument{"VectorEnvironment needs an instance generator."};
+		}
+	}
+
+	/**
+	 * Batch default constructed environments.
+	 */
+	VectorEnvironment(
+		std::size_t n_envs,
+		std::shared_ptr<instance::InstanceGenerator> instance_generator,
+		std::size_t n_workers = 0,
+		std::size_t max_reset_trials = default_max_reset_trials) :
+		VectorEnvironment(std::vector<Env>(n_envs), std::move(instance_generator), n_workers, max_reset_trials) {}
+
+	/**
+	 * Seed all environments with seeds derived from the given one.
+	 */
+	void seed(Seed new_seed) {
+		auto rng = RandomGenerator{new_seed};
+		for (auto& env : the_envs) {
+			env.seed(rng());
+		}
+	}
+
+	/**
+	 * Reset all environments on new instances from the instance generator.
+	 *
+	 * Instances on which the initial state is also terminal are skipped.
+	 *
+	 * @throw IteratorExhausted If the instance generator is exhausted.
+	 * @throw std::runtime_error If the initial state of max_reset_trials consecutive instances is terminal.
+	 * @return The batch of observations, action sets, rewards, done flags, and informations, in the order of the
+	 *         environments.
+	 */
+	auto reset() -> Batch {
+		return run_on_workers([this](std::size_t i) { return reset_non_terminal(the_envs[i]); });
+	}
+
+	/**
+	 * Transition all environments with one action each.
+	 *
+	 * Environments reaching a terminal state are reset on a new instance, as in reset.
+	 *
+	 * @param actions The actions to take, in the order of the environments.
+	 * @return The batch of observations, action sets, rewards, done flags, and informations, in the order of the
+	 *         environments.
+	 * @pre A call to reset must have been done prior to transitioning.
+	 */
+	auto step(std::vector<Action> const& actions) -> Batch {
+		if (actions.size() != the_envs.size()) {
+			throw std::invalid_argument{"Expected one action per environment."};
+		}
+		return run_on_workers([this, &actions](std::size_t i) {
+			auto transition = the_envs[i].step(actions[i]);
+			if (std::get<3>(transition)) {
+				// Only keep the new initial state, the reward and done flag still relate to the terminal transition
+				auto initial = reset_non_terminal(the_envs[i]);
+				std::get<0>(transition) = std::move(std::get<0>(initial));
+				std::get<1>(transition) = std::move(std::get<1>(initial));
+			}
+			return transition;
+		});
+	}
+
+	[[nodiscard]] auto size() const noexcept { return the_envs.size(); }
+	[[nodiscard]] auto n_workers() const noexcept { return the_n_workers; }
+	auto& envs() { return the_envs; }
+	auto& env(std::size_t i) { return the_envs.at(i); }
+	auto& instance_generator() { return *the_instance_generator; }
+
+private:
+	using Transition = std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>;
+
+	std::vector<Env> the_envs;
+	std::shared_ptr<instance::InstanceGenerator> the_instance_generator;
+	std::mutex the_instance_generator_mutex;
+	std::size_t the_n_workers;
+	std::size_t the_max_reset_trials;
+	utility::ThreadPool the_thread_pool;
+
+	/**
+	 * Draw a new instance, instance generators are not thread safe.
+	 *
+	 * Environments are not always stepped on the same worker thread, so instances using the
+	 * ``utility::CoroutineBackend::Context`` backend, that cannot be resumed from another thread, are switched to the
+	 * ``utility::CoroutineBackend::ThreadPool`` backend.
+	 */
+	auto next_instance() -> scip::Model {
+		auto model = [this] {
+			auto const lk = std::lock_guard{the_instance_generator_mutex};
+			if (the_instance_generator->done()) {
+				throw IteratorExhausted{};
+			}
+			return the_instance_generator->next();
+		}();
+		if (model.coroutine_backend() == utility::CoroutineBackend::Context) {
+			model.set_coroutine_backend(utility::CoroutineBackend::ThreadPool);
+		}
+		return model;
+	}
+
+	auto reset_non_terminal(Env& env) -> Transition {
+		for (std::size_t trial = 0; trial < the_max_reset_trials; ++trial) {
+			auto transition = env.reset(next_instance());
+			if (!std::get<3>(transition)) {
+				return transition;
+			}
+		}
+		throw std::runtime_error{"All instances drawn to reset an environment were solved during the reset."};
+	}
+
+	/**
+	 * Call the function on every environment index and gather the transitions in a batch.
+	 *
+	 * Worker w processes the environments w, w + n_workers, w + 2 * n_workers, etc.
+	 * All workers are waited for before rethrowing the first exception.
+	 */
+	template <typename Func> auto run_on_workers(Func const& func) -> Batch {
+		auto transitions = std::vector<std::optional<Transition>>(the_envs.size());
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(the_n_workers);
+		for (std::size_t w = 0; w < the_n_workers; ++w) {
+			futures.push_back(the_thread_pool.submit([&func, &transitions, w, this] {
+				for (auto i = w; i < the_envs.size(); i += the_n_workers) {
+					transitions[i] = func(i);
+				}
+			}));
+		}
+		auto error = std::exception_ptr{};
+		for (auto& fut : futures) {
+			try {
+				fut.get();
+			} catch (...) {
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+
+		auto batch = Batch{};
+		auto& [observations, action_sets, rewards, dones, informations] = batch;
+		observations.reserve(transitions.size());
+		action_sets.reserve(transitions.size());
+		rewards.reserve(transitions.size());
+		dones.reserve(transitions.size());
+		informations.reserve(transitions.size());
+		for (auto& transition : transitions) {
+			auto& [obs, action_set, reward, done, info] = transition.value();
+			observations.push_back(std::move(obs));
+			action_sets.push_back(std::move(action_set));
+			rewards.push_back(reward);
+			dones.push_back(done);
+			informations.push_back(std::move(info));
+		}
+		return batch;
+	}
+};
+
+}  // namespace ecole::environment
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/abstract.hpp"
+
+namespace ecole::observation {
+
+/** Strong branching evaluation of a branching candidate. */
+struct ECOLE_EXPORT StrongBranchingCandidate {
+	SCIP_VAR* variable = nullptr;
+	/** Value of the variable in the LP solution. */
+	SCIP_Real lp_value = 0.;
+	/** Branching score, estimated from the pseudocosts when the candidate is not evaluated. */
+	SCIP_Real score = 0.;
+	/** Whether the children were solved by strong branching, within the budget. */
+	bool evaluated = false;
+	/**
+	 * Whether the children were solved to optimality (or proven infeasible) within the iteration limit.
+	 *
+	 * Never set when some columns are not in the LP (``SCIPallColsInLP``), since the children are then only solved on
+	 * a restriction of their LP.
+	 */
+	bool exact = false;
+	/** Dual bound of the down and up children used in the score, when evaluated, only proven valid when exact. */
+	SCIP_Real down_bound = 0.;
+	SCIP_Real up_bound = 0.;
+	/** Whether the down and up children were proven infeasible, never set when some columns are not in the LP. */
+	bool down_infeasible = false;
+	bool up_infeasible = false;
+};
+
+struct ECOLE_EXPORT BudgetedStrongBranchingScoresObs {
+	/** Score of each variable, NaN for variables that are not branching candidates. */
+	xt::xtensor<double, 1> scores;
+	/** Whether the score of each variable was computed by strong branching to optimality, rather than estimated. */
+	xt::xtensor<bool, 1> exact;
+};
+
+/**
+ * Strong branching scores computed within a budget.
+ *
+ * Candidates are ordered by decreasing pseudocost score, and evaluated by strong branching in that order until the
+ * budget is exhausted.
+ * Candidates that are not evaluated keep their pseudocost score, and are not flagged as exact.
+ * Without any limit, the scores are the same as those of StrongBranchingScores.
+ */
+class ECOLE_EXPORT BudgetedStrongBranchingScores {
+public:
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Whether to score the pseudo branching candidates rather than the LP ones.
+	 * @param iteration_limit Maximum number of LP iterations for each child of a candidate.
+	 * @param time_limit Wall clock time, in seconds, after which no new candidate is evaluated.
+	 * @param top_k Maximum number of candidates evaluated, the ones with the best pseudocost scores.
+	 * @param n_threads Number of threads evaluating candidates on independent copies of the current LP, or zero to use
+	 * SCIP strong branching on the LP of the model.
+	 */
+	ECOLE_EXPORT BudgetedStrongBranchingScores(
+		bool pseudo_candidates = false,
+		std::optional<int> iteration_limit = {},
+		std::optional<double> time_limit = {},
+		std::optional<std::size_t> top_k = {},
+		std::size_t n_threads = 0);
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<BudgetedStrongBranchingScoresObs>;
+
+	/** Same as extract, but take the branching candidates from the given context. */
+	ECOLE_EXPORT auto extract_in_context(scip::Model& model, bool done, data::StepContext& context) const
+		-> std::optional<BudgetedStrongBranchingScoresObs>;
+
+	/**
+	 * Evaluate the branching candidates of the current node, in the solving stage.
+	 *
+	 * @return The candidates, by decreasing pseudocost score.
+	 */
+	ECOLE_EXPORT auto evaluate(scip::Model& model, data::StepContext& context) const
+		-> std::vector<StrongBranchingCandidate>;
+
+private:
+	bool pseudo_candidates;
+	std::optional<int> iteration_limit;
+	std::optional<double> time_limit;
+	std::optional<std::size_t> top_k;
+	std::size_t n_threads;
+};
+
+}  // namespace ecole::observation
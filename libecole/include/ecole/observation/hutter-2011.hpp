@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <unordered_map>
 
 #include <xtensor/xtensor.hpp>
 
@@ -10,7 +14,7 @@
 namespace ecole::observation {
 
 struct ECOLE_EXPORT Hutter2011Obs {
-	static inline std::size_t constexpr n_features = 33;
+	static inline std::size_t constexpr n_features = 35;
 
 	enum struct ECOLE_EXPORT Features : std::size_t {
 		/* Problem size features */
@@ -33,11 +37,12 @@ struct ECOLE_EXPORT Hutter2011Obs {
 		node_degree_std,
 		node_degree_25q,
 		node_degree_75q,
-		// Not computed because too expensive
-		// clustering_coef_mean,
-		// clustering_coef_std,
+		clustering_coef_mean,
+		clustering_coef_std,
 		edge_density,
 		/* LP features */
+		// When the LP relaxation is not solved to optimality, the slacks are NaN, and the objective value is +/-inf
+		// if the LP is infeasible or unbounded (worse or better than any solution), and NaN otherwise.
 		lp_slack_mean,
 		lp_slack_max,
 		lp_slack_l2,
@@ -65,12 +70,48 @@ struct ECOLE_EXPORT Hutter2011Obs {
 	};
 
 	xt::xtensor<double, 1> features;
+	/** Standard error of each feature, zero when computed exactly, and NaN when estimated without known error. */
+	xt::xtensor<double, 1> standard_errors;
 };
 
 class ECOLE_EXPORT Hutter2011 {
 public:
+	/** LP based features, in the order of Hutter2011Obs::Features. */
+	using LpFeatures = std::array<double, 4>;
+	/** LP based features of the instances already seen, keyed by a fingerprint of their LP relaxation. */
+	using LpFeaturesMemo = std::unordered_map<std::uint64_t, LpFeatures>;
+	/** Maximum number of instances whose LP based features are memoized. */
+	static inline constexpr std::size_t lp_memo_capacity = 1024;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param graph_budget Maximum size of the variable graph, as the sum over constraints of their squared number of
+	 * variables, beyond which the variable graph features are estimated from a sample of variables.
+	 * No limit if not given.
+	 * @param n_samples Number of variables sampled to estimate the variable graph features (at least two).
+	 * @param triangle_budget Maximum number of steps of triangle counting, as the sum over edges oriented from lower to
+	 * higher degree of the forward degree of their head, beyond which the clustering coefficients of a variable graph
+	 * within the graph budget are estimated by sampling pairs of neighbours.
+	 * No limit if not given.
+	 */
+	ECOLE_EXPORT Hutter2011(
+		std::optional<std::size_t> graph_budget = {},
+		std::size_t n_samples = 1000,
+		std::optional<std::size_t> triangle_budget = {}) noexcept;
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Hutter2011Obs>;
+
+	/** Number of LP relaxations solved so far, the features of the other instances being taken from the memo. */
+	[[nodiscard]] auto n_lp_solved() const noexcept -> std::size_t { return lp_solve_count; }
+
+private:
+	std::optional<std::size_t> graph_budget;
+	std::optional<std::size_t> triangle_budget;
+	std::size_t n_samples;
+	LpFeaturesMemo lp_memo;
+	std::size_t lp_solve_count = 0;
 };
 
 }  // namespace ecole::observation
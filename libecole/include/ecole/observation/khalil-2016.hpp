@@ -104,19 +104,69 @@ struct ECOLE_EXPORT Khalil2016Obs {
 		active_coef_weight4_max,
 	};
 
+	/** One row per variable, or one row per branching candidate when only candidates are observed. */
 	xt::xtensor<double, 2> features;
+	/** Problem index of each branching candidate, in the order of the Branching environment action set. */
+	xt::xtensor<std::size_t, 1> candidates;
 };
 
 class ECOLE_EXPORT Khalil2016 {
 public:
-	ECOLE_EXPORT Khalil2016(bool pseudo_candidates = false) noexcept;
+	/**
+	 * The model is only read, static features are stored in this object.
+	 *
+	 * Row activities, that SCIP computes lazily, are computed beforehand by StepContext::prepare_concurrent_reads.
+	 */
+	static inline constexpr bool read_only = true;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Observe the pseudo branching candidates rather than the LP ones.
+	 * @param candidates_only Only write the rows of the branching candidates, in the order of candidates, rather
+	 * than one row per variable.
+	 */
+	ECOLE_EXPORT Khalil2016(bool pseudo_candidates = false, bool candidates_only = false) noexcept;
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Khalil2016Obs>;
 
+	/** Same as extract, but take the branching candidates from the given context. */
+	ECOLE_EXPORT auto extract_in_context(scip::Model& model, bool done, data::StepContext& context)
+		-> std::optional<Khalil2016Obs>;
+
+	/** Same as extract, but reuse the memory of the given observation. */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, std::optional<Khalil2016Obs>& obs) -> void;
+
+	/** Same as extract_into, but take the branching candidates from the given context. */
+	ECOLE_EXPORT auto extract_into(
+		scip::Model& model,
+		bool done,
+		std::optional<Khalil2016Obs>& obs,
+		data::StepContext& context) -> void;
+
+	/**
+	 * Same as extract_into, but write in an existing observation.
+	 *
+	 * @return Whether there is an observation, otherwise the given one is left untouched.
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, Khalil2016Obs& obs, data::StepContext& context)
+		-> bool;
+
+	/**
+	 * Whether extracting in the given observation keeps the shape of all its arrays, so that none of them is
+	 * reallocated.
+	 *
+	 * Only the number of variables and branching candidates are read.
+	 * False if there is no observation to extract.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto
+	keeps_shapes_of(scip::Model& model, Khalil2016Obs const& obs, data::StepContext& context) const -> bool;
+
 private:
 	bool pseudo_candidates;
+	bool candidates_only;
 	xt::xtensor<double, 2> static_features;
 };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 
 #include <xtensor/xtensor.hpp>
@@ -10,10 +12,8 @@
 
 namespace ecole::observation {
 
-class ECOLE_EXPORT MilpBipartiteObs {
-public:
-	using value_type = double;
-
+/** Features of MilpBipartiteObs, common to all precisions. */
+struct ECOLE_EXPORT MilpBipartiteFeatures {
 	static inline std::size_t constexpr n_variable_features = 9;
 	enum struct ECOLE_EXPORT VariableFeatures : std::size_t {
 		objective = 0,
@@ -30,22 +30,49 @@ public:
 	enum struct ECOLE_EXPORT ConstraintFeatures : std::size_t {
 		bias = 0,
 	};
+};
+
+/** Bipartite observation with features stored as Value and edge indices stored as Index. */
+template <typename Value, typename Index> struct ECOLE_EXPORT BasicMilpBipartiteObs : MilpBipartiteFeatures {
+	using value_type = Value;
+	using index_type = Index;
 
 	xt::xtensor<value_type, 2> variable_features;
 	xt::xtensor<value_type, 2> constraint_features;
-	utility::coo_matrix<value_type> edge_features;
+	/** Edges in coordinate format, empty when extracted in compressed rows. */
+	utility::coo_matrix<value_type, index_type> edge_features;
+	/** Edges in compressed rows, empty unless extracted in compressed rows. */
+	utility::csr_matrix<value_type, index_type> edge_features_csr;
 };
 
-class ECOLE_EXPORT MilpBipartite {
+using MilpBipartiteObs = BasicMilpBipartiteObs<double, std::size_t>;
+using MilpBipartiteObsF32I32 = BasicMilpBipartiteObs<float, std::int32_t>;
+using MilpBipartiteObsF32I64 = BasicMilpBipartiteObs<float, std::int64_t>;
+
+template <typename Value, typename Index> class ECOLE_EXPORT BasicMilpBipartite {
 public:
-	MilpBipartite(bool normalize_ = false) : normalize{normalize_} {}
+	using Observation = BasicMilpBipartiteObs<Value, Index>;
+
+	/**
+	 * Extraction only reads variables and constraints.
+	 *
+	 * The objective norm, that SCIP computes lazily, is computed beforehand by StepContext::prepare_concurrent_reads.
+	 */
+	static inline constexpr bool read_only = true;
+
+	BasicMilpBipartite(bool normalize_ = false, bool csr_ = false) : normalize{normalize_}, csr{csr_} {}
 
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<MilpBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<Observation>;
 
 private:
 	bool normalize = false;
+	bool csr = false;
 };
 
+using MilpBipartite = BasicMilpBipartite<double, std::size_t>;
+using MilpBipartiteF32I32 = BasicMilpBipartite<float, std::int32_t>;
+using MilpBipartiteF32I64 = BasicMilpBipartite<float, std::int64_t>;
+
 }  // namespace ecole::observation
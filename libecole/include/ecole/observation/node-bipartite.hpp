@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <xtensor/xtensor.hpp>
 
@@ -10,9 +14,8 @@
 
 namespace ecole::observation {
 
-struct ECOLE_EXPORT NodeBipartiteObs {
-	using value_type = double;
-
+/** Features of NodeBipartiteObs, common to all precisions. */
+struct ECOLE_EXPORT NodeBipartiteFeatures {
 	static inline std::size_t constexpr n_static_variable_features = 5;
 	static inline std::size_t constexpr n_dynamic_variable_features = 14;
 	static inline std::size_t constexpr n_variable_features = n_static_variable_features + n_dynamic_variable_features;
@@ -54,24 +57,137 @@ struct ECOLE_EXPORT NodeBipartiteObs {
 		dual_solution_value,
 		scaled_age,
 	};
+};
+
+/**
+ * Bipartite observation with features stored as Value and edge indices stored as Index.
+ *
+ * Features are computed in double precision and converted when written.
+ */
+template <typename Value, typename Index> struct ECOLE_EXPORT BasicNodeBipartiteObs : NodeBipartiteFeatures {
+	using value_type = Value;
+	using index_type = Index;
 
 	xt::xtensor<value_type, 2> variable_features;
 	xt::xtensor<value_type, 2> row_features;
-	utility::coo_matrix<value_type> edge_features;
+	/** Edges in coordinate format, empty when extracted in compressed rows. */
+	utility::coo_matrix<value_type, index_type> edge_features;
+	/** Edges in compressed rows, empty unless extracted in compressed rows. */
+	utility::csr_matrix<value_type, index_type> edge_features_csr;
 };
 
-class ECOLE_EXPORT NodeBipartite {
+using NodeBipartiteObs = BasicNodeBipartiteObs<double, std::size_t>;
+using NodeBipartiteObsF32I32 = BasicNodeBipartiteObs<float, std::int32_t>;
+using NodeBipartiteObsF32I64 = BasicNodeBipartiteObs<float, std::int64_t>;
+
+template <typename Value, typename Index> class ECOLE_EXPORT BasicNodeBipartite {
 public:
-	NodeBipartite(bool cache = false) : use_cache{cache} {}
+	using Observation = BasicNodeBipartiteObs<Value, Index>;
+
+	/**
+	 * Extraction only reads the LP, without modifying the model.
+	 *
+	 * Reduced costs, row activities, and the objective norm, that SCIP computes lazily, are computed beforehand by
+	 * StepContext::prepare_concurrent_reads.
+	 */
+	static inline constexpr bool read_only = true;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param cache Compute static features on the root node only and reuse them for the rest of the episode.
+	 *        This is only exact if the LP rows do not change, for instance when cutting planes are disabled.
+	 * @param incremental Reuse the edges and static features of LP rows that did not change since the last
+	 *        extraction, and only compute them for the rows that were added or modified.
+	 *        Unlike cache, the observation stays exact when the LP changes.
+	 *        Modified rows are reported by an event handler included in the model by before_reset.
+	 * @param csr Write the edges in compressed rows in edge_features_csr, rather than in coordinate format.
+	 * @param n_threads_ Number of threads sharing the extraction of variables, rows, and edges.
+	 *        The observation is the same for any number of threads.
+	 *        This does not apply to incremental extraction.
+	 */
+	BasicNodeBipartite(bool cache = false, bool incremental = false, bool csr = false, std::size_t n_threads_ = 1) :
+		use_cache{cache}, use_incremental{incremental}, use_csr{csr}, n_threads{n_threads_} {}
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<NodeBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Observation>;
+
+	/** Same as extract, but take the norms and number of LPs from the given context. */
+	ECOLE_EXPORT auto extract_in_context(scip::Model& model, bool done, data::StepContext& context)
+		-> std::optional<Observation>;
+
+	/**
+	 * Same as extract, but write the observation in place.
+	 *
+	 * The memory of the given observation is reused when the number of variables, rows, and non zeros do not change.
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, std::optional<Observation>& obs) -> void;
+
+	/** Same as extract_into, but take the norms and number of LPs from the given context. */
+	ECOLE_EXPORT auto extract_into(
+		scip::Model& model,
+		bool done,
+		std::optional<Observation>& obs,
+		data::StepContext& context) -> void;
+
+	/**
+	 * Same as extract_into, but write in an existing observation.
+	 *
+	 * @return Whether there is an observation, otherwise the given one is left untouched.
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, Observation& obs, data::StepContext& context)
+		-> bool;
+
+	/**
+	 * Whether extracting in the given observation keeps the shape of all the arrays written, so that none of them is
+	 * reallocated.
+	 *
+	 * Only the sizes of the LP are read, so this is cheap compared to an extraction.
+	 * False if there is no observation to extract.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto
+	keeps_shapes_of(scip::Model& model, Observation const& obs, data::StepContext& context) const -> bool;
 
 private:
-	NodeBipartiteObs the_cache;
+	/**
+	 * Position of an LP row in the observation.
+	 *
+	 * Modifications of the coefficients and sides of rows are reported by events, but not the ones that only move
+	 * coefficients, such as columns entering the LP or SCIP sorting the row, which are detected here instead.
+	 */
+	struct RowSignature {
+		int index;
+		int n_lp_nonz;
+		bool has_lhs;
+		bool has_rhs;
+		bool lp_cols_sorted;
+		std::size_t feat_row_idx;
+		std::size_t nnz_idx;
+	};
+
+	/** The previous observation, updated in place, that observations are copied from. */
+	Observation the_cache;
+	/** Buffer where rows are rebuilt when the LP rows change, then swapped with the cache. */
+	Observation scratch;
+	std::vector<RowSignature> row_signatures;
+	/** Position in row_signatures, plus one, of the previous rows by row index, zero elsewhere. */
+	std::vector<std::size_t> previous_rows;
+	/** Name of the event handler reporting modified rows. */
+	std::string row_events_name;
+	/** Number of row events reported at the last extraction. */
+	std::uint64_t n_row_events = 0;
 	bool use_cache = false;
+	bool use_incremental = false;
+	bool use_csr = false;
+	std::size_t n_threads = 1;
 	bool cache_computed = false;
+
+	auto extract_observation_incrementally(scip::Model& model, Observation& obs, data::StepContext& context) -> void;
 };
 
+using NodeBipartite = BasicNodeBipartite<double, std::size_t>;
+using NodeBipartiteF32I32 = BasicNodeBipartite<float, std::int32_t>;
+using NodeBipartiteF32I64 = BasicNodeBipartite<float, std::int64_t>;
+
 }  // namespace ecole::observation
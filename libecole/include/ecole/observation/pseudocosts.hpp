@@ -11,9 +11,37 @@ namespace ecole::observation {
 
 class ECOLE_EXPORT Pseudocosts {
 public:
+	/** Pseudocosts are queried without being updated, and the branching candidates are taken from the context. */
+	static inline constexpr bool read_only = true;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param candidates_only Only write the pseudocosts of the LP branching candidates, in the order of the
+	 * Branching environment action set, rather than one pseudocost per variable.
+	 */
+	ECOLE_EXPORT Pseudocosts(bool candidates_only = false) noexcept;
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<xt::xtensor<double, 1>>;
+
+	/** Same as extract, but take the branching candidates from the given context. */
+	ECOLE_EXPORT auto extract_in_context(scip::Model& model, bool done, data::StepContext& context)
+		-> std::optional<xt::xtensor<double, 1>>;
+
+	/** Same as extract, but reuse the memory of the given tensor. */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, std::optional<xt::xtensor<double, 1>>& obs) -> void;
+
+	/** Same as extract_into, but take the branching candidates from the given context. */
+	ECOLE_EXPORT auto extract_into(
+		scip::Model& model,
+		bool done,
+		std::optional<xt::xtensor<double, 1>>& obs,
+		data::StepContext& context) -> void;
+
+private:
+	bool candidates_only;
 };
 
 }  // namespace ecole::observation
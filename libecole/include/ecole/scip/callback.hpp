@@ -1,8 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <tuple>
 #include <variant>
 
+#include <scip/type_result.h>
 #include <scip/type_timing.h>
 #include <scip/type_tree.h>
 
@@ -46,6 +48,14 @@ template <> struct Constructor<Type::Branchrule> {
 	int priority = priority_max;
 	int max_depth = max_depth_none;
 	double max_bound_distance = max_bound_distance_none;
+	/**
+	 * Branchrule methods on which iterative solving pauses.
+	 *
+	 * The other methods directly return ``SCIP_DIDNOTRUN`` in the solving thread, without giving back control.
+	 */
+	bool pause_on_lp = true;
+	bool pause_on_external = true;
+	bool pause_on_pseudo = true;
 };
 using BranchruleConstructor = Constructor<Type::Branchrule>;
 
@@ -95,4 +105,11 @@ using NodeselCall = Call<Type::Nodesel>;
 
 using DynamicCall = std::variant<Call<Type::Branchrule>, Call<Type::Heuristic>, Call<Type::Nodesel>>;
 
+/**
+ * Function called in place by reverse callbacks when solving in direct mode.
+ *
+ * It recieves the callback arguments and returns the result to give to SCIP.
+ */
+using DirectHandler = std::function<SCIP_RESULT(DynamicCall)>;
+
 }  // namespace ecole::scip::callback
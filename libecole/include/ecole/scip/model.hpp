@@ -24,6 +24,10 @@
 #include "ecole/utility/type-traits.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+namespace ecole::utility {
+enum struct CoroutineBackend;
+}  // namespace ecole::utility
+
 namespace ecole::scip {
 
 /* Forward declare scip holder type */
@@ -57,6 +61,11 @@ public:
 	 *
 	 * Ownership of the pointer is however not released by the Model.
 	 * This function is meant to use the original C API of SCIP.
+	 * Copies made while the model is being copied by another thread may come from a private snapshot of the model.
+	 * Snapshots are discarded on every call to this function, or when the variables, objective, or number of
+	 * constraints change.
+	 * After changing constraints in place through a pointer kept from an earlier call, call this function again
+	 * before copying the model.
 	 */
 	[[nodiscard]] ECOLE_EXPORT SCIP* get_scip_ptr() noexcept;
 	[[nodiscard]] ECOLE_EXPORT SCIP const* get_scip_ptr() const noexcept;
@@ -144,6 +153,18 @@ public:
 	[[nodiscard]] ECOLE_EXPORT SCIP_Real primal_bound() const noexcept;
 	[[nodiscard]] ECOLE_EXPORT SCIP_Real dual_bound() const noexcept;
 
+	/**
+	 * Get and set the mechanism used to run iterative solving.
+	 *
+	 * With ``utility::CoroutineBackend::Thread``, SCIP runs in a separate thread.
+	 * With ``utility::CoroutineBackend::ThreadPool``, that thread is reused across episodes and models.
+	 * With ``utility::CoroutineBackend::Context``, SCIP runs on a separate stack in the calling thread, which avoids
+	 * creating a thread per episode and makes every pause and resume a cheap context switch.
+	 * The value is preserved by ``copy`` and ``copy_orig`` and only takes effect on the next call to ``solve_iter``.
+	 */
+	[[nodiscard]] ECOLE_EXPORT utility::CoroutineBackend coroutine_backend() const noexcept;
+	ECOLE_EXPORT void set_coroutine_backend(utility::CoroutineBackend backend) noexcept;
+
 	/**
 	 * Start iterative solving.
 	 *
@@ -211,6 +232,25 @@ public:
 	 */
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
 
+	/**
+	 * Solve with reverse callbacks handled in place (direct mode).
+	 *
+	 * Rather than pausing and giving control back like ``solve_iter``, the reverse callbacks call the handler
+	 * synchronously, from within SCIP.
+	 * There is no coroutine involved, making it as fast as a native SCIP plugin.
+	 * Exceptions thrown by the handler make SCIP stop and are rethrown by this function.
+	 *
+	 * @param arg_packs A sequence of construtors parameters defining the reverse callback to use.
+	 * @param handler A function called with the callback arguments and returning the result to give to SCIP.
+	 */
+	ECOLE_EXPORT auto
+	solve_direct(nonstd::span<callback::DynamicConstructor const> arg_packs, callback::DirectHandler handler) -> void;
+
+	/**
+	 * Solve in direct mode with a single callback.
+	 */
+	ECOLE_EXPORT auto solve_direct(callback::DynamicConstructor arg_pack, callback::DirectHandler handler) -> void;
+
 private:
 	std::unique_ptr<Scimpl> scimpl;
 };
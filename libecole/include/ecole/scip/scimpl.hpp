@@ -12,7 +12,8 @@
 
 namespace ecole::utility {
 template <typename Return, typename Message> class Coroutine;
-}
+enum struct CoroutineBackend;
+}  // namespace ecole::utility
 
 namespace ecole::scip {
 
@@ -20,27 +21,44 @@ struct ECOLE_EXPORT ScipDeleter {
 	ECOLE_EXPORT void operator()(SCIP* ptr);
 };
 
+class SnapshotPool;
+
 class ECOLE_EXPORT Scimpl {
 public:
 	ECOLE_EXPORT Scimpl();
 	ECOLE_EXPORT Scimpl(Scimpl&& /*other*/) noexcept;
-	ECOLE_EXPORT Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& /*scip_ptr*/) noexcept;
+	ECOLE_EXPORT Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& /*scip_ptr*/);
 	ECOLE_EXPORT ~Scimpl();
 
+	/**
+	 * Mutable access to the SCIP pointer, marks the snapshots used for concurrent copies as outdated.
+	 *
+	 * Modifications made through a pointer kept from an earlier call are only detected by snapshots if they change the
+	 * variables, the objective, or the number of constraints.
+	 */
 	ECOLE_EXPORT auto get_scip_ptr() noexcept -> SCIP*;
+	ECOLE_EXPORT auto get_scip_ptr() const noexcept -> SCIP const*;
 
 	[[nodiscard]] ECOLE_EXPORT auto copy() const -> Scimpl;
 	[[nodiscard]] ECOLE_EXPORT auto copy_orig() const -> Scimpl;
 
+	[[nodiscard]] ECOLE_EXPORT auto coroutine_backend() const noexcept -> utility::CoroutineBackend;
+	ECOLE_EXPORT auto set_coroutine_backend(utility::CoroutineBackend backend) noexcept -> void;
+
 	ECOLE_EXPORT auto solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 		-> std::optional<callback::DynamicCall>;
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
 
+	ECOLE_EXPORT auto
+	solve_direct(nonstd::span<callback::DynamicConstructor const> arg_packs, callback::DirectHandler handler) -> void;
+
 private:
 	using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT>;
 
 	std::unique_ptr<SCIP, ScipDeleter> m_scip;
+	std::unique_ptr<SnapshotPool> m_snapshots;
 	std::unique_ptr<Controller> m_controller;
+	utility::CoroutineBackend m_coroutine_backend;
 };
 
 }  // namespace ecole::scip
@@ -42,6 +42,21 @@ struct has_before_reset<
 	std::true_type {};
 template <typename T> inline constexpr bool has_before_reset_v = has_before_reset<T>::value;
 
+/**
+ * Check that a type has a `before_transition` member function.
+ *
+ * This member function is optional for data functions.
+ * The type must have member function with the signature compatible with
+ * `auto before_transition(scip::Model&) -> void;`.
+ */
+template <typename, typename = void> struct has_before_transition : std::false_type {};
+template <typename T>
+struct has_before_transition<
+	T,
+	std::enable_if_t<std::is_void_v<decltype(std::declval<T>().before_transition(std::declval<scip::Model&>()))>>> :
+	std::true_type {};
+template <typename T> inline constexpr bool has_before_transition_v = has_before_transition<T>::value;
+
 /**
  * Check that a type has an `extract` member function.
  *
@@ -56,6 +71,62 @@ struct has_extract<
 	std::enable_if_t<!std::is_void_v<decltype(std::declval<T>().extract(std::declval<scip::Model&>(), true))>>> :
 	std::true_type {};
 
+/**
+ * Check that a type has an `extract_into` member function.
+ *
+ * This member function is optional for data functions.
+ * The type must have member function with the signature compatible with
+ * `auto extract_into(scip::Model&, bool, Data&) -> void;`.
+ * where `Data` is the type returned by `extract`.
+ */
+template <typename, typename = void> struct has_extract_into : std::false_type {};
+template <typename T>
+struct has_extract_into<
+	T,
+	std::enable_if_t<std::is_void_v<decltype(std::declval<T>().extract_into(
+		std::declval<scip::Model&>(),
+		true,
+		std::declval<decltype(std::declval<T>().extract(std::declval<scip::Model&>(), true))&>()))>>> :
+	std::true_type {};
+template <typename T> inline constexpr bool has_extract_into_v = has_extract_into<T>::value;
+
+/**
+ * Check that a type has an `extract_in_context` member function.
+ *
+ * This member function is optional for data functions.
+ * The type must have member function with the signature compatible with
+ * `auto extract_in_context(scip::Model&, bool, data::StepContext&) -> Data;`.
+ * where `Data` is the type returned by `extract`.
+ */
+template <typename, typename = void> struct has_extract_in_context : std::false_type {};
+template <typename T>
+struct has_extract_in_context<
+	T,
+	std::enable_if_t<std::is_same_v<
+		decltype(std::declval<T>().extract_in_context(
+			std::declval<scip::Model&>(), true, std::declval<data::StepContext&>())),
+		decltype(std::declval<T>().extract(std::declval<scip::Model&>(), true))>>> : std::true_type {};
+template <typename T> inline constexpr bool has_extract_in_context_v = has_extract_in_context<T>::value;
+
+/**
+ * Check that a type has an `extract_into` member function also taking a context.
+ *
+ * This member function is optional for data functions.
+ * The type must have member function with the signature compatible with
+ * `auto extract_into(scip::Model&, bool, Data&, data::StepContext&) -> void;`.
+ * where `Data` is the type returned by `extract`.
+ */
+template <typename, typename = void> struct has_extract_into_in_context : std::false_type {};
+template <typename T>
+struct has_extract_into_in_context<
+	T,
+	std::enable_if_t<std::is_void_v<decltype(std::declval<T>().extract_into(
+		std::declval<scip::Model&>(),
+		true,
+		std::declval<decltype(std::declval<T>().extract(std::declval<scip::Model&>(), true))&>(),
+		std::declval<data::StepContext&>()))>>> : std::true_type {};
+template <typename T> inline constexpr bool has_extract_into_in_context_v = has_extract_into_in_context<T>::value;
+
 template <typename, template <typename> typename, typename = void> struct extract_return_is : std::false_type {};
 template <typename T, template <typename> typename Pred>
 struct extract_return_is<T, Pred, std::void_t<decltype(&T::extract)>> :
@@ -67,6 +138,18 @@ template <typename T>
 using is_data_function = std::conjunction<internal::has_before_reset<T>, internal::has_extract<T>>;
 template <typename T> inline constexpr bool is_data_function_v = is_data_function<T>::value;
 
+/**
+ * Check that a data function declares that it only reads the model.
+ *
+ * The type must have a static member `read_only` set to true.
+ * Such functions may be extracted concurrently with one another on the same model, once
+ * StepContext::prepare_concurrent_reads has filled the quantities that SCIP caches lazily, and reported that it could.
+ */
+template <typename, typename = void> struct is_read_only_function : std::false_type {};
+template <typename T>
+struct is_read_only_function<T, std::enable_if_t<T::read_only>> : std::conjunction<is_data_function<T>> {};
+template <typename T> inline constexpr bool is_read_only_function_v = is_read_only_function<T>::value;
+
 template <typename T> using is_observation_function = is_data_function<T>;
 template <typename T> inline constexpr bool is_observation_function_v = is_observation_function<T>::value;
 
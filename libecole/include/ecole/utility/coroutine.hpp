@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -9,8 +14,97 @@
 #include <utility>
 #include <variant>
 
+#include "ecole/export.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#if defined(__linux__) && __has_include(<ucontext.h>)
+#include <ucontext.h>
+#define ECOLE_HAS_UCONTEXT 1
+#endif
+
 namespace ecole::utility {
 
+/**
+ * Mechanism used by a Coroutine to run its executor.
+ */
+enum struct CoroutineBackend {
+	/** The executor runs in its own OS thread, synchronized with a mutex and a condition variable. */
+	Thread,
+	/**
+	 * Same as ``Thread`` but the thread is borrowed from the process-wide ``ThreadPool``.
+	 *
+	 * Threads outlive the coroutines, which avoids creating and joining a thread on every coroutine.
+	 */
+	ThreadPool,
+	/**
+	 * The executor runs on its own stack in the thread of the coroutine.
+	 *
+	 * Control is passed back and forth with user-space context switches (``swapcontext``), so no OS thread is
+	 * created and no synchronization is needed.
+	 * The executor is started lazily, on the first call to ``wait``.
+	 * Context switches do not switch thread local storage, so the coroutine is pinned to the thread that started the
+	 * executor, and waiting on it from any other thread throws a ``std::logic_error``.
+	 */
+	Context,
+};
+
+/** Whether the ``CoroutineBackend::Context`` backend is supported on this platform. */
+#ifdef ECOLE_HAS_UCONTEXT
+inline constexpr bool has_context_coroutine_backend = true;
+#else
+inline constexpr bool has_context_coroutine_backend = false;
+#endif
+
+/** Backend used when none is given, selected at build time with the ``ECOLE_COROUTINE_BACKEND`` CMake option. */
+#if defined(ECOLE_COROUTINE_BACKEND_CONTEXT) && defined(ECOLE_HAS_UCONTEXT)
+inline constexpr auto default_coroutine_backend = CoroutineBackend::Context;
+#elif defined(ECOLE_COROUTINE_BACKEND_THREADPOOL)
+inline constexpr auto default_coroutine_backend = CoroutineBackend::ThreadPool;
+#else
+inline constexpr auto default_coroutine_backend = CoroutineBackend::Thread;
+#endif
+
+/** Size of the stack allocated for executors running with the ``CoroutineBackend::Context`` backend. */
+inline constexpr std::size_t coroutine_context_stack_size = std::size_t{8} << 20U;
+
+/**
+ * Number of times a thread polls for its turn before blocking on a condition variable.
+ *
+ * Only used by the ``Thread`` and ``ThreadPool`` backends.
+ * With a budget of zero (the default), threads always block, which avoids burning CPU.
+ * With a positive budget, threads first spin on an atomic state, which avoids sleeping and waking up the thread
+ * (two futex system calls per handoff) when the other side answers quickly.
+ * The value is read when a coroutine is created, and ignored on single core machines.
+ */
+[[nodiscard]] ECOLE_EXPORT auto coroutine_spin_budget() noexcept -> std::size_t;
+ECOLE_EXPORT auto set_coroutine_spin_budget(std::size_t budget) noexcept -> void;
+
+/** Process-wide counters of handoffs made by coroutines with a positive spin budget. */
+struct CoroutineHandoffStats {
+	/** Number of handoffs completed without blocking the thread. */
+	std::uint64_t n_spin_hits = 0;
+	/** Number of handoffs where the thread had to block on the condition variable. */
+	std::uint64_t n_parks = 0;
+};
+
+[[nodiscard]] ECOLE_EXPORT auto coroutine_handoff_stats() noexcept -> CoroutineHandoffStats;
+ECOLE_EXPORT auto reset_coroutine_handoff_stats() noexcept -> void;
+
+namespace internal {
+
+ECOLE_EXPORT auto record_coroutine_handoff(bool parked) noexcept -> void;
+
+/** Hint the CPU that the thread is busy waiting. */
+inline auto cpu_relax() noexcept -> void {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+}  // namespace internal
+
 /**
  * Asynchronous cooperative interruptable code execution.
  *
@@ -33,7 +127,7 @@ public:
 	using MaybeReturn = std::optional<Return>;
 
 	/**
-	 * Start the execution.
+	 * Start the execution with the ``default_coroutine_backend``.
 	 *
 	 * @param func Function used to define the code that needs to be executed by the executor.
 	 *        The first parameter to that function is a ``std::weak_ptr<Executor>`` used to yield values and recieve
@@ -43,6 +137,16 @@ public:
 	 */
 	template <class Function, class... Args> Coroutine(Function&& func, Args&&... args);
 
+	/**
+	 * Start the execution with the given backend.
+	 *
+	 * @param backend The mechanism used to run the executor.
+	 * @param func Function used to define the code that needs to be executed by the executor.
+	 * @param args Additional parameters to be passed as additinal arguments to ``func``.
+	 * @throw std::invalid_argument If the backend is not supported on this platform.
+	 */
+	template <class Function, class... Args> Coroutine(CoroutineBackend backend, Function&& func, Args&&... args);
+
 	/**
 	 * Terminate the coroutine
 	 *
@@ -84,9 +188,18 @@ private:
 	 */
 	using Lock = std::unique_lock<std::mutex>;
 
-	/** Class responsible for synchronizing between the coroutine and executor. */
+	/**
+	 * Class responsible for synchronizing between the coroutine and executor.
+	 *
+	 * With the ``CoroutineBackend::Context`` backend, the locks passed around are empty and control is transfered
+	 * by switching context instead.
+	 */
 	class Synchronizer {
 	public:
+		Synchronizer(CoroutineBackend backend);
+
+		[[nodiscard]] auto backend() const noexcept -> CoroutineBackend;
+
 		auto coroutine_wait_executor() -> Lock;
 		auto coroutine_pop_return() -> Return;
 		auto coroutine_resume_executor(Lock&& lk, MessageOrStop instruction) -> void;
@@ -98,17 +211,38 @@ private:
 		auto executor_terminate(Lock&& lk) -> void;
 		auto executor_terminate(Lock&& lk, std::exception_ptr const& e) -> void;
 
+		/** Prepare the executor stack so that ``entry`` is run on the first ``coroutine_wait_executor``. */
+		auto context_start(std::function<void()>&& entry) -> void;
+
 	private:
 		std::exception_ptr m_executor_exception = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
 		std::mutex m_exclusion_mutex;
 		std::condition_variable m_resume_signal;
-		bool m_executor_running = true;
+		std::atomic<bool> m_executor_running = true;
+		std::atomic<int> m_n_parked = 0;
+		std::size_t m_spin_budget = 0;
 		bool m_executor_finished = false;
 		Return m_value;
 		MessageOrStop m_instruction;
-
+		CoroutineBackend m_backend;
+#ifdef ECOLE_HAS_UCONTEXT
+		std::function<void()> m_context_entry;
+		std::unique_ptr<char[]> m_context_stack;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+		ucontext_t m_coroutine_context{};
+		ucontext_t m_executor_context{};
+		/** The thread that started the executor, the only one allowed to switch to it. */
+		std::thread::id m_context_thread{};
+
+		static auto context_trampoline(unsigned int address_high, unsigned int address_low) -> void;
+#endif
+
+		[[nodiscard]] auto is_context() const noexcept -> bool;
+		auto handoff(Lock&& lk, bool executor_running) -> void;
+		template <typename Predicate> auto wait_until(Predicate&& is_ready) -> Lock;
 		[[nodiscard]] auto is_valid_lock(Lock const& lk) const noexcept -> bool;
 		auto maybe_throw(Lock&& lk) -> Lock;
+		auto context_switch_to_executor() -> void;
+		auto context_switch_to_coroutine() -> void;
 	};
 
 public:
@@ -151,6 +285,7 @@ public:
 private:
 	std::shared_ptr<Synchronizer> m_synchronizer;
 	std::thread executor_thread;
+	std::future<void> m_pooled_executor_done;
 	Lock m_exclusion_lock;
 
 	auto stop_executor() -> void;
@@ -158,6 +293,9 @@ private:
 }  // namespace ecole::utility
 
 #include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -169,11 +307,31 @@ namespace ecole::utility {
  *  Implementation of Coroutine::Synchronizer  *
  ***********************************************/
 
+template <typename Return, typename Message>
+Coroutine<Return, Message>::Synchronizer::Synchronizer(CoroutineBackend backend) : m_backend{backend} {
+	if ((backend == CoroutineBackend::Context) && !has_context_coroutine_backend) {
+		throw std::invalid_argument{"The context coroutine backend is not supported on this platform."};
+	}
+	// Spinning is pointless when there is no other core for the other thread to make progress on.
+	if (!is_context() && (std::thread::hardware_concurrency() > 1)) {
+		m_spin_budget = coroutine_spin_budget();
+	}
+}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::backend() const noexcept -> CoroutineBackend {
+	return m_backend;
+}
+
 template <typename Return, typename Message>
 auto Coroutine<Return, Message>::Synchronizer::coroutine_wait_executor() -> Lock {
-	Lock lk{m_exclusion_mutex};
-	m_resume_signal.wait(lk, [this] { return !m_executor_running; });
-	return maybe_throw(std::move(lk));
+	if (is_context()) {
+		if (m_executor_running) {
+			context_switch_to_executor();
+		}
+		return maybe_throw(Lock{});
+	}
+	return maybe_throw(wait_until([this] { return !m_executor_running; }));
 }
 
 template <typename Return, typename Message>
@@ -186,9 +344,11 @@ auto Coroutine<Return, Message>::Synchronizer::coroutine_resume_executor(Lock&&
 	-> void {
 	assert(is_valid_lock(lk));
 	m_instruction = std::move(new_instruction);
-	m_executor_running = true;
-	lk.unlock();
-	m_resume_signal.notify_one();
+	if (is_context()) {
+		m_executor_running = true;
+		return;
+	}
+	handoff(std::move(lk), true);
 }
 
 template <typename Return, typename Message>
@@ -199,6 +359,9 @@ auto Coroutine<Return, Message>::Synchronizer::coroutine_executor_is_done(
 }
 
 template <typename Return, typename Message> auto Coroutine<Return, Message>::Synchronizer::executor_start() -> Lock {
+	if (is_context()) {
+		return Lock{};
+	}
 	return Lock{m_exclusion_mutex};
 }
 
@@ -206,22 +369,27 @@ template <typename Return, typename Message>
 auto Coroutine<Return, Message>::Synchronizer::executor_yield(Lock&& lk, Return value)
 	-> std::pair<Lock, MessageOrStop> {
 	assert(is_valid_lock(lk));
-	m_executor_running = false;
 	m_value = value;
-	lk.unlock();
-	m_resume_signal.notify_one();
-	lk.lock();
-	m_resume_signal.wait(lk, [this] { return m_executor_running; });
-	return {std::move(lk), std::move(m_instruction)};
+	if (is_context()) {
+		m_executor_running = false;
+		context_switch_to_coroutine();
+		return {std::move(lk), std::move(m_instruction)};
+	}
+	handoff(std::move(lk), false);
+	auto new_lk = wait_until([this] { return m_executor_running.load(); });
+	return {std::move(new_lk), std::move(m_instruction)};
 }
 
 template <typename Return, typename Message>
 auto Coroutine<Return, Message>::Synchronizer::executor_terminate(Lock&& lk) -> void {
 	assert(is_valid_lock(lk));
-	m_executor_running = false;
 	m_executor_finished = true;
-	lk.unlock();
-	m_resume_signal.notify_one();
+	if (is_context()) {
+		// Control returns to the coroutine when the entry function returns.
+		m_executor_running = false;
+		return;
+	}
+	handoff(std::move(lk), false);
 }
 
 template <typename Return, typename Message>
@@ -231,8 +399,66 @@ auto Coroutine<Return, Message>::Synchronizer::executor_terminate(Lock&& lk, std
 	executor_terminate(std::move(lk));
 }
 
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::is_context() const noexcept -> bool {
+	return m_backend == CoroutineBackend::Context;
+}
+
+/**
+ * Release the lock and notify the other thread that the executor state changed.
+ *
+ * When spinning, the state is published after unlocking so that a spinning thread does not then block on the mutex.
+ * The other thread is only notified if it is parked, which is safe because parking threads increment the park
+ * count before checking the state (both operations being sequentially consistent).
+ */
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::handoff(Lock&& lk, bool executor_running) -> void {
+	assert(is_valid_lock(lk));
+	if (m_spin_budget == 0) {
+		m_executor_running = executor_running;
+		lk.unlock();
+		m_resume_signal.notify_one();
+		return;
+	}
+	lk.unlock();
+	m_executor_running = executor_running;
+	if (m_n_parked > 0) {
+		// Wait for the parked thread to be inside the condition variable to not miss the notification.
+		{ auto const guard = Lock{m_exclusion_mutex}; }
+		m_resume_signal.notify_all();
+	}
+}
+
+/** Acquire the lock once the predicate is true, spinning first if there is a spin budget. */
+template <typename Return, typename Message>
+template <typename Predicate>
+auto Coroutine<Return, Message>::Synchronizer::wait_until(Predicate&& is_ready) -> Lock {
+	if (m_spin_budget == 0) {
+		Lock lk{m_exclusion_mutex};
+		m_resume_signal.wait(lk, is_ready);
+		return lk;
+	}
+	for (std::size_t i = 0; i < m_spin_budget; ++i) {
+		if (is_ready()) {
+			internal::record_coroutine_handoff(false);
+			return Lock{m_exclusion_mutex};
+		}
+		internal::cpu_relax();
+	}
+	Lock lk{m_exclusion_mutex};
+	++m_n_parked;
+	auto const parked = !is_ready();
+	m_resume_signal.wait(lk, is_ready);
+	--m_n_parked;
+	internal::record_coroutine_handoff(parked);
+	return lk;
+}
+
 template <typename Return, typename Message>
 auto Coroutine<Return, Message>::Synchronizer::is_valid_lock(Lock const& lk) const noexcept -> bool {
+	if (is_context()) {
+		return !lk;
+	}
 	return lk && (lk.mutex() == &m_exclusion_mutex);
 }
 
@@ -248,6 +474,72 @@ auto Coroutine<Return, Message>::Synchronizer::maybe_throw(Lock&& lk) -> Lock {
 	return std::move(lk);
 }
 
+#ifdef ECOLE_HAS_UCONTEXT
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_start(std::function<void()>&& entry) -> void {
+	assert(is_context());
+	m_context_entry = std::move(entry);
+	// Not using make_unique to avoid touching (zero-initializing) the whole stack.
+	m_context_stack.reset(new char[coroutine_context_stack_size]);  // NOLINT(cppcoreguidelines-owning-memory)
+	if (getcontext(&m_executor_context) != 0) {
+		throw std::runtime_error{"Could not initialize the coroutine context."};
+	}
+	m_executor_context.uc_stack.ss_sp = m_context_stack.get();
+	m_executor_context.uc_stack.ss_size = coroutine_context_stack_size;
+	m_executor_context.uc_link = &m_coroutine_context;
+	// makecontext only forwards int arguments, so the address of the synchronizer is split in two.
+	auto const address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(this));
+	makecontext(
+		&m_executor_context,
+		reinterpret_cast<void (*)()>(&Synchronizer::context_trampoline),  // NOLINT
+		2,
+		static_cast<unsigned int>(address >> 32U),
+		static_cast<unsigned int>(address & 0xFFFFFFFFU));
+}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_trampoline(unsigned int address_high, unsigned int address_low)
+	-> void {
+	auto const address = (static_cast<std::uint64_t>(address_high) << 32U) | static_cast<std::uint64_t>(address_low);
+	auto* const self = reinterpret_cast<Synchronizer*>(static_cast<std::uintptr_t>(address));  // NOLINT
+	// Moved out so that the resources it holds are released before leaving the executor stack.
+	auto entry = std::move(self->m_context_entry);
+	entry();
+}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_switch_to_executor() -> void {
+	// Thread local variables (such as errno, or those of SCIP and the standard library) would otherwise be those of
+	// another thread when the executor is resumed.
+	if (m_context_thread == std::thread::id{}) {
+		m_context_thread = std::this_thread::get_id();
+	} else if (m_context_thread != std::this_thread::get_id()) {
+		throw std::logic_error{"A context coroutine can only be resumed from the thread that started it."};
+	}
+	swapcontext(&m_coroutine_context, &m_executor_context);
+}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_switch_to_coroutine() -> void {
+	swapcontext(&m_executor_context, &m_coroutine_context);
+}
+
+#else
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_start(std::function<void()>&& /*entry*/) -> void {
+	throw std::invalid_argument{"The context coroutine backend is not supported on this platform."};
+}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_switch_to_executor() -> void {}
+
+template <typename Return, typename Message>
+auto Coroutine<Return, Message>::Synchronizer::context_switch_to_coroutine() -> void {}
+
+#endif
+
 /*******************************************
  *  Implementation of Coroutine::Executor  *
  *******************************************/
@@ -288,7 +580,12 @@ auto Coroutine<Return, Message>::Executor::terminate(std::exception_ptr&& except
 template <typename Return, typename Message>
 template <typename Function, typename... Args>
 Coroutine<Return, Message>::Coroutine(Function&& func_, Args&&... args_) :
-	m_synchronizer(std::make_shared<Synchronizer>()) {
+	Coroutine{default_coroutine_backend, std::forward<Function>(func_), std::forward<Args>(args_)...} {}
+
+template <typename Return, typename Message>
+template <typename Function, typename... Args>
+Coroutine<Return, Message>::Coroutine(CoroutineBackend backend, Function&& func_, Args&&... args_) :
+	m_synchronizer(std::make_shared<Synchronizer>(backend)) {
 	auto executor = std::make_shared<Executor>(m_synchronizer);
 
 	auto executor_func = [executor](Function&& func, Args&&... args) {
@@ -308,20 +605,42 @@ Coroutine<Return, Message>::Coroutine(Function&& func_, Args&&... args_) :
 		}
 	};
 
-	executor_thread = std::thread(executor_func, std::forward<Function>(func_), std::forward<Args>(args_)...);
+	if (backend == CoroutineBackend::Thread) {
+		executor_thread = std::thread(executor_func, std::forward<Function>(func_), std::forward<Args>(args_)...);
+		return;
+	}
+
+	auto entry = [executor_func,
+		func = std::decay_t<Function>{std::forward<Function>(func_)},
+		args = std::tuple<std::decay_t<Args>...>{std::forward<Args>(args_)...}]() mutable {
+		std::apply([&](auto&... unpacked) { executor_func(std::move(func), std::move(unpacked)...); }, args);
+	};
+	if (backend == CoroutineBackend::ThreadPool) {
+		m_pooled_executor_done = ThreadPool::global().submit(std::move(entry));
+	} else {
+		m_synchronizer->context_start(std::move(entry));
+	}
 }
 
 template <typename Return, typename Message> Coroutine<Return, Message>::~Coroutine() noexcept {
 	assert(std::this_thread::get_id() != executor_thread.get_id());
-	if (executor_thread.joinable()) {
+	auto const has_executor = executor_thread.joinable() || m_pooled_executor_done.valid() ||
+		(m_synchronizer->backend() == CoroutineBackend::Context);
+	if (has_executor) {
 		try {
 			stop_executor();
 		} catch (...) {
 			// if the Coroutine<Return, Message> is deleted but not waited on, then we ignore potential
 			// exceptions
 		}
+	}
+	if (executor_thread.joinable()) {
 		executor_thread.join();
 	}
+	// Same guarantee as join: the executor function and its captures are destroyed when this returns.
+	if (m_pooled_executor_done.valid()) {
+		m_pooled_executor_done.wait();
+	}
 }
 
 template <typename Return, typename Message> auto Coroutine<Return, Message>::wait() -> MaybeReturn {
@@ -12,15 +12,17 @@ namespace ecole::utility {
  * Simple coordinate sparse matrix.
  *
  * Indices are given with shape (2, nnz, that is indices[0] are row indices and indices[1] are columns indicies.
+ * The index type can be made smaller than the default to reduce the memory of large matrices.
  *
  * FIXME there is early development of a sparse xtensor to replace this class, but it still a bit early.
  * https://github.com/xtensor-stack/xtensor-sparse
  */
-template <typename T> struct coo_matrix {
+template <typename T, typename I = std::size_t> struct coo_matrix {
 	using value_type = T;
+	using index_type = I;
 
 	xt::xtensor<value_type, 1> values;
-	xt::xtensor<std::size_t, 2> indices;
+	xt::xtensor<index_type, 2> indices;
 	std::array<std::size_t, 2> shape = {0, 0};
 
 	using Tuple = std::tuple<decltype(values), decltype(indices), decltype(shape)>;
@@ -35,23 +37,114 @@ template <typename T> struct coo_matrix {
 	auto operator==(coo_matrix const& other) const -> bool;
 };
 
+/**
+ * Simple compressed sparse row matrix.
+ *
+ * The column indices and values of row i are stored from position indptr[i] to indptr[i+1] (excluded) in indices and
+ * values.
+ * This saves the storage of the row indices compared to coo_matrix, and is the layout expected by most sparse
+ * matrix products.
+ */
+template <typename T, typename I = std::size_t> struct csr_matrix {
+	using value_type = T;
+	using index_type = I;
+
+	xt::xtensor<value_type, 1> values;
+	xt::xtensor<index_type, 1> indices;
+	xt::xtensor<index_type, 1> indptr;
+	std::array<std::size_t, 2> shape = {0, 0};
+
+	using Tuple = std::tuple<decltype(values), decltype(indices), decltype(indptr), decltype(shape)>;
+
+	[[nodiscard]] static auto from_tuple(Tuple t) -> csr_matrix;
+
+	[[nodiscard]] auto to_tuple() const& -> Tuple;
+	[[nodiscard]] auto to_tuple() && -> Tuple;
+
+	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
+
+	auto operator==(csr_matrix const& other) const -> bool;
+};
+
+/**
+ * Convert a coo_matrix into a csr_matrix.
+ *
+ * The memory of the output is reused when the number of rows and non zeros do not change.
+ * Coefficients keep their relative order within a row, so the conversion is a copy when the coo_matrix rows are
+ * already sorted.
+ * Values and indices are converted to the types of the csr_matrix while being placed, without intermediary copy.
+ */
+template <typename T, typename I, typename U, typename J>
+auto coo_to_csr(coo_matrix<T, I> const& coo, csr_matrix<U, J>& csr) -> void;
+
 /**********************************
  *  Implementation of coo_matrix  *
  **********************************/
 
-template <typename T> auto coo_matrix<T>::from_tuple(Tuple t) -> coo_matrix {
+template <typename T, typename I> auto coo_matrix<T, I>::from_tuple(Tuple t) -> coo_matrix {
 	return std::apply([](auto&&... vals) { return coo_matrix{std::forward<decltype(vals)>(vals)...}; }, std::move(t));
 }
 
-template <typename T> auto coo_matrix<T>::to_tuple() const& -> Tuple {
+template <typename T, typename I> auto coo_matrix<T, I>::to_tuple() const& -> Tuple {
 	return {values, indices, shape};
 }
-template <typename T> auto coo_matrix<T>::to_tuple() && -> Tuple {
+template <typename T, typename I> auto coo_matrix<T, I>::to_tuple() && -> Tuple {
 	return {std::move(values), std::move(indices), shape};
 }
 
-template <typename T> auto coo_matrix<T>::operator==(coo_matrix const& other) const -> bool {
+template <typename T, typename I> auto coo_matrix<T, I>::operator==(coo_matrix const& other) const -> bool {
 	return std::tie(values, indices, shape) == std::tie(other.values, other.indices, other.shape);
 }
 
+/**********************************
+ *  Implementation of csr_matrix  *
+ **********************************/
+
+template <typename T, typename I> auto csr_matrix<T, I>::from_tuple(Tuple t) -> csr_matrix {
+	return std::apply([](auto&&... vals) { return csr_matrix{std::forward<decltype(vals)>(vals)...}; }, std::move(t));
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::to_tuple() const& -> Tuple {
+	return {values, indices, indptr, shape};
+}
+template <typename T, typename I> auto csr_matrix<T, I>::to_tuple() && -> Tuple {
+	return {std::move(values), std::move(indices), std::move(indptr), shape};
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::operator==(csr_matrix const& other) const -> bool {
+	return std::tie(values, indices, indptr, shape) == std::tie(other.values, other.indices, other.indptr, other.shape);
+}
+
+template <typename T, typename I, typename U, typename J>
+auto coo_to_csr(coo_matrix<T, I> const& coo, csr_matrix<U, J>& csr) -> void {
+	auto const n_rows = coo.shape[0];
+	auto const nnz = coo.nnz();
+	csr.shape = coo.shape;
+	csr.values.resize({nnz});
+	csr.indices.resize({nnz});
+	csr.indptr.resize({n_rows + 1});
+
+	// Count the coefficients in each row, shifted by one, then accumulate them into row starts
+	csr.indptr.fill(0);
+	for (std::size_t k = 0; k < nnz; ++k) {
+		csr.indptr[static_cast<std::size_t>(coo.indices(0, k)) + 1]++;
+	}
+	for (std::size_t row = 0; row < n_rows; ++row) {
+		csr.indptr[row + 1] += csr.indptr[row];
+	}
+
+	// Place each coefficient after the ones of the same row already placed, using indptr as the insertion position
+	for (std::size_t k = 0; k < nnz; ++k) {
+		auto const row = static_cast<std::size_t>(coo.indices(0, k));
+		auto const pos = static_cast<std::size_t>(csr.indptr[row]++);
+		csr.indices[pos] = static_cast<J>(coo.indices(1, k));
+		csr.values[pos] = static_cast<U>(coo.values[k]);
+	}
+	// Insertion positions ended at the start of the next row, shift them back
+	for (std::size_t row = n_rows; row > 0; --row) {
+		csr.indptr[row] = csr.indptr[row - 1];
+	}
+	csr.indptr[0] = 0;
+}
+
 }  // namespace ecole::utility
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/**
+ * A pool of long-lived threads to run tasks.
+ *
+ * The pool grows on demand so that a submitted task never waits for another one to finish.
+ * This is required to run coroutine executors, which block until the end of their coroutine.
+ * Threads that finish a task become idle and are reused by later tasks instead of being destroyed.
+ */
+class ECOLE_EXPORT ThreadPool {
+public:
+	/**
+	 * The process-wide pool.
+	 *
+	 * It is never destroyed so that it can safely be used during static destruction.
+	 */
+	ECOLE_EXPORT static auto global() -> ThreadPool&;
+
+	ThreadPool() = default;
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	/** Wait for all submitted tasks to finish and join all threads. */
+	ECOLE_EXPORT ~ThreadPool();
+
+	/**
+	 * Run a task in one of the thread of the pool.
+	 *
+	 * An idle thread is used if there is one, otherwise a new thread is created.
+	 *
+	 * @return A future becoming ready once the task and all the resources it holds are destroyed.
+	 *         Exceptions thrown by the task are forwarded to the future.
+	 */
+	ECOLE_EXPORT auto submit(std::function<void()> task) -> std::future<void>;
+
+	/** Number of threads owned by the pool. */
+	[[nodiscard]] ECOLE_EXPORT auto n_threads() const -> std::size_t;
+
+	/** Number of threads waiting for a task. */
+	[[nodiscard]] ECOLE_EXPORT auto n_idle_threads() const -> std::size_t;
+
+private:
+	struct Task {
+		std::function<void()> function;
+		std::promise<void> done;
+	};
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_task_available;
+	std::deque<Task> m_tasks;
+	std::vector<std::thread> m_threads;
+	std::size_t m_n_idle = 0;
+	bool m_stopping = false;
+
+	auto worker_loop() -> void;
+};
+
+}  // namespace ecole::utility
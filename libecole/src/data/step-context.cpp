@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include <scip/scip.h>
+
+#include "ecole/data/step-context.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::data {
+
+/** Every quantity is computed once, the flags being replaced with the whole memo on invalidation. */
+struct StepContext::Memo {
+	std::once_flag n_lps_flag;
+	SCIP_Longint n_lps = 0;
+	std::once_flag obj_norm_flag;
+	SCIP_Real obj_norm = 0.;
+	std::once_flag lp_row_norms_flag;
+	std::vector<SCIP_Real> lp_row_norms;
+	std::once_flag lp_branch_cands_flag;
+	BranchCands lp_branch_cands;
+	std::once_flag pseudo_branch_cands_flag;
+	BranchCands pseudo_branch_cands;
+};
+
+namespace {
+
+template <typename T, typename Func> auto memoize(std::once_flag& flag, T& value, Func&& func) -> T& {
+	std::call_once(flag, [&value, &func] { value = func(); });
+	return value;
+}
+
+auto make_branch_cands(nonstd::span<SCIP_VAR*> const variables) -> StepContext::BranchCands {
+	auto cands = StepContext::BranchCands{};
+	cands.variables.assign(variables.begin(), variables.end());
+	cands.indices = xt::xtensor<std::size_t, 1>::from_shape({variables.size()});
+	std::transform(variables.begin(), variables.end(), cands.indices.begin(), [](auto* const var) {
+		return static_cast<std::size_t>(SCIPvarGetProbindex(var));
+	});
+	return cands;
+}
+
+}  // namespace
+
+StepContext::StepContext() : memo{std::make_unique<Memo>()} {}
+
+StepContext::StepContext(StepContext&& /*other*/) noexcept = default;
+StepContext& StepContext::operator=(StepContext&& /*other*/) noexcept = default;
+StepContext::~StepContext() = default;
+
+auto StepContext::invalidate() -> void {
+	memo = std::make_unique<Memo>();
+}
+
+auto StepContext::prepare_concurrent_reads(scip::Model& model) -> bool {
+	auto* const scip = model.get_scip_ptr();
+	auto const stage = SCIPgetStage(scip);
+	if ((stage < SCIP_STAGE_TRANSFORMED) || (stage > SCIP_STAGE_SOLVED)) {
+		return false;
+	}
+	[[maybe_unused]] auto const norm = obj_norm(model);
+	// Without a solved LP, reduced costs and row activities may be computed on access, which is not safe to do
+	// concurrently.
+	if ((stage != SCIP_STAGE_SOLVING) || !SCIPhasCurrentNodeLP(scip) ||
+	    (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)) {
+		return false;
+	}
+	[[maybe_unused]] auto const n = n_lps(model);
+	[[maybe_unused]] auto const norms = lp_row_norms(model);
+	[[maybe_unused]] auto const& lp_cands = lp_branch_cands(model);
+	[[maybe_unused]] auto const& pseudo_cands = pseudo_branch_cands(model);
+	// Reduced costs and row activities are computed on first access, and cached until the LP changes.
+	for (auto* const col : model.lp_columns()) {
+		[[maybe_unused]] auto const redcost = SCIPgetColRedcost(scip, col);
+	}
+	for (auto* const row : model.lp_rows()) {
+		[[maybe_unused]] auto const activity = SCIPgetRowLPActivity(scip, row);
+	}
+	return true;
+}
+
+auto StepContext::n_lps(scip::Model& model) -> SCIP_Longint {
+	return memoize(memo->n_lps_flag, memo->n_lps, [&model] { return SCIPgetNLPs(model.get_scip_ptr()); });
+}
+
+auto StepContext::obj_norm(scip::Model& model) -> SCIP_Real {
+	return memoize(memo->obj_norm_flag, memo->obj_norm, [&model] { return SCIPgetObjNorm(model.get_scip_ptr()); });
+}
+
+auto StepContext::lp_row_norms(scip::Model& model) -> nonstd::span<SCIP_Real const> {
+	auto const& norms = memoize(memo->lp_row_norms_flag, memo->lp_row_norms, [&model] {
+		auto const rows = model.lp_rows();
+		auto row_norms = std::vector<SCIP_Real>(rows.size());
+		std::transform(
+			rows.begin(), rows.end(), row_norms.begin(), [](auto* const row) { return SCIProwGetNorm(row); });
+		return row_norms;
+	});
+	return {norms.data(), norms.size()};
+}
+
+auto StepContext::lp_branch_cands(scip::Model& model) -> BranchCands const& {
+	return memoize(memo->lp_branch_cands_flag, memo->lp_branch_cands, [&model] {
+		SCIP_VAR** vars = nullptr;
+		SCIP_Real* lp_values = nullptr;
+		int n_vars = 0;
+		scip::call(SCIPgetLPBranchCands, model.get_scip_ptr(), &vars, &lp_values, nullptr, &n_vars, nullptr, nullptr);
+		auto const n_cands = static_cast<std::size_t>(n_vars);
+		auto cands = make_branch_cands({vars, n_cands});
+		cands.lp_values.assign(lp_values, lp_values + n_cands);
+		return cands;
+	});
+}
+
+auto StepContext::pseudo_branch_cands(scip::Model& model) -> BranchCands const& {
+	return memoize(memo->pseudo_branch_cands_flag, memo->pseudo_branch_cands, [&model] {
+		return make_branch_cands(model.pseudo_branch_cands());
+	});
+}
+
+}  // namespace ecole::data
@@ -40,40 +40,59 @@ auto keep_solving_until_next_LP_callback(scip::Model& model, FCall& fcall, bool
 			return {false, action_set(model, pseudo_candidates)};
 		}
 		// Otherwise keep looping, ignoring the callback.
+		// Not expected since other methods are filtered in the reverse callback, see branchrule_constructor.
 		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
 	}
 	// Solving is finished.
 	return {true, {}};
 }
 
+/** Apply the branching decision and return the result to give to SCIP. */
+auto branch(scip::Model& model, Defaultable<std::size_t> maybe_var_idx) -> SCIP_RESULT {
+	// Default fallback to SCIP default branching
+	if (!std::holds_alternative<std::size_t>(maybe_var_idx)) {
+		return SCIP_DIDNOTRUN;
+	}
+	auto const var_idx = std::get<std::size_t>(maybe_var_idx);
+	auto const vars = model.variables();
+	// Error handling
+	if (var_idx >= vars.size()) {
+		throw std::invalid_argument{
+			fmt::format("Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
+	}
+	// Branching
+	scip::call(SCIPbranchVar, model.get_scip_ptr(), vars[var_idx], nullptr, nullptr, nullptr);
+	return SCIP_BRANCHED;
+}
+
+/** Pause only on LP branching, other branchrule methods are let to SCIP without leaving the solving thread. */
+auto branchrule_constructor() noexcept -> scip::callback::BranchruleConstructor {
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.pause_on_external = false;
+	constructor.pause_on_pseudo = false;
+	return constructor;
+}
+
 }  // namespace
 
 auto BranchingDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
-	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	auto fcall = model.solve_iter(branchrule_constructor());
 	return keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
 }
 
 auto BranchingDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t> maybe_var_idx) const
 	-> std::tuple<bool, ActionSet> {
-	// Default fallback to SCIP default branching
-	auto scip_result = SCIP_DIDNOTRUN;
-
-	if (std::holds_alternative<std::size_t>(maybe_var_idx)) {
-		auto const var_idx = std::get<std::size_t>(maybe_var_idx);
-		auto const vars = model.variables();
-		// Error handling
-		if (var_idx >= vars.size()) {
-			throw std::invalid_argument{
-				fmt::format("Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
-		}
-		// Branching
-		scip::call(SCIPbranchVar, model.get_scip_ptr(), vars[var_idx], nullptr, nullptr, nullptr);
-		scip_result = SCIP_BRANCHED;
-	}
-
+	auto const scip_result = branch(model, maybe_var_idx);
 	// Looping until the next LP branchrule rule callback, if it exists.
 	auto fcall = model.solve_iter_continue(scip_result);
 	return keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
 }
 
+auto BranchingDynamics::solve_with_policy(scip::Model& model, Policy const& policy) const -> void {
+	// Only called on LP branching, the other methods are filtered by the reverse branchrule.
+	model.solve_direct(branchrule_constructor(), [&](scip::callback::DynamicCall const& /*call*/) {
+		return branch(model, policy(model, action_set(model, pseudo_candidates)));
+	});
+}
+
 }  // namespace ecole::dynamics
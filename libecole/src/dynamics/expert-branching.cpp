@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/data/step-context.hpp"
+#include "ecole/dynamics/expert-branching.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::dynamics {
+
+using Candidate = observation::StrongBranchingCandidate;
+
+namespace {
+
+/** Pause only on LP branching, other branchrule methods are let to SCIP without leaving the solving thread. */
+auto branchrule_constructor() noexcept -> scip::callback::BranchruleConstructor {
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.pause_on_external = false;
+	constructor.pause_on_pseudo = false;
+	return constructor;
+}
+
+/** The candidate with the best score, the first one in case of ties. */
+auto best_candidate(std::vector<Candidate> const& evaluation) -> Candidate const& {
+	assert(!evaluation.empty());
+	return *std::max_element(evaluation.begin(), evaluation.end(), [](auto const& cand1, auto const& cand2) {
+		return cand1.score < cand2.score;
+	});
+}
+
+/**
+ * Whether the strong branching result of a candidate is proven for its real children, and can be given to SCIP.
+ *
+ * When some columns are not in the LP, children are only solved on a restriction of their LP.
+ */
+auto is_reusable(SCIP* const scip, Candidate const& cand) -> bool {
+	return cand.evaluated && cand.exact && SCIPallColsInLP(scip);
+}
+
+/**
+ * Apply the domain reductions of the candidates with an infeasible child.
+ *
+ * @return The result to give to SCIP if the node does not need to be branched on, that is if it is infeasible.
+ */
+auto reduce_domains(SCIP* const scip, std::vector<Candidate> const& evaluation) -> std::optional<SCIP_RESULT> {
+	for (auto const& cand : evaluation) {
+		if (!is_reusable(scip, cand) || !(cand.down_infeasible || cand.up_infeasible)) {
+			continue;
+		}
+		if (cand.down_infeasible && cand.up_infeasible) {
+			return SCIP_CUTOFF;
+		}
+		SCIP_Bool infeasible = false;
+		SCIP_Bool tightened = false;
+		if (cand.down_infeasible) {
+			auto const new_lb = SCIPfeasCeil(scip, cand.lp_value - 1.) + 1.;
+			scip::call(SCIPtightenVarLb, scip, cand.variable, new_lb, true, &infeasible, &tightened);
+		} else {
+			auto const new_ub = SCIPfeasFloor(scip, cand.lp_value + 1.) - 1.;
+			scip::call(SCIPtightenVarUb, scip, cand.variable, new_ub, true, &infeasible, &tightened);
+		}
+		if (infeasible) {
+			return SCIP_CUTOFF;
+		}
+	}
+	return {};
+}
+
+}  // namespace
+
+ExpertBranchingDynamics::ExpertBranchingDynamics(
+	bool pseudo_candidates,
+	std::optional<int> iteration_limit,
+	std::optional<double> time_limit,
+	std::optional<std::size_t> top_k,
+	std::size_t n_threads) :
+	expert{pseudo_candidates, iteration_limit, time_limit, top_k, n_threads} {}
+
+/** Evaluate the candidates of the node where the solver is paused, and keep the evaluation for the next step. */
+auto ExpertBranchingDynamics::action_set(scip::Model& model) -> ActionSet {
+	evaluation.clear();
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto context = data::StepContext{};
+	evaluation = expert.evaluate(model, context);
+
+	auto const n_cands = evaluation.size();
+	auto action_set = ExpertBranchingActionSet{
+		xt::xtensor<std::size_t, 1>::from_shape({n_cands}),
+		xt::xtensor<double, 1>::from_shape({n_cands}),
+		xt::xtensor<bool, 1>::from_shape({n_cands}),
+	};
+	for (std::size_t cand_idx = 0; cand_idx < n_cands; ++cand_idx) {
+		auto const& cand = evaluation[cand_idx];
+		action_set.candidates[cand_idx] = static_cast<std::size_t>(SCIPvarGetProbindex(cand.variable));
+		action_set.scores[cand_idx] = static_cast<double>(cand.score);
+		action_set.exact[cand_idx] = cand.exact;
+	}
+	action_set.expert_action = static_cast<std::size_t>(SCIPvarGetProbindex(best_candidate(evaluation).variable));
+	return action_set;
+}
+
+/**
+ * Apply the branching decision, reusing the strong branching evaluation of the node.
+ *
+ * If the chosen variable has an infeasible child, its domain is reduced instead, and SCIP solves the node again.
+ * Otherwise the dual bound of the children is updated with their strong branching bound.
+ * Only exact results, with all columns in the LP, are reused; otherwise the variable is simply branched on.
+ */
+auto ExpertBranchingDynamics::branch(scip::Model& model, Action maybe_var_idx) -> SCIP_RESULT {
+	auto* const scip = model.get_scip_ptr();
+	auto const vars = model.variables();
+	// Default to the expert decision
+	auto var_idx = static_cast<std::size_t>(SCIPvarGetProbindex(best_candidate(evaluation).variable));
+	if (std::holds_alternative<std::size_t>(maybe_var_idx)) {
+		var_idx = std::get<std::size_t>(maybe_var_idx);
+	}
+	// Error handling
+	if (var_idx >= vars.size()) {
+		throw std::invalid_argument{fmt::format(
+			"Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
+	}
+
+	if (auto const result = reduce_domains(scip, evaluation); result.has_value()) {
+		return result.value();
+	}
+	auto* const var = vars[var_idx];
+	auto const chosen = std::find_if(
+		evaluation.begin(), evaluation.end(), [var](auto const& cand) { return cand.variable == var; });
+	auto const reuse = (chosen != evaluation.end()) && is_reusable(scip, *chosen);
+	if (reuse && (chosen->down_infeasible || chosen->up_infeasible)) {
+		return SCIP_REDUCEDDOM;
+	}
+
+	// Branching
+	SCIP_NODE* down_child = nullptr;
+	SCIP_NODE* up_child = nullptr;
+	scip::call(SCIPbranchVar, scip, var, &down_child, nullptr, &up_child);
+	if (reuse) {
+		if (down_child != nullptr) {
+			scip::call(SCIPupdateNodeLowerbound, scip, down_child, chosen->down_bound);
+		}
+		if (up_child != nullptr) {
+			scip::call(SCIPupdateNodeLowerbound, scip, up_child, chosen->up_bound);
+		}
+	}
+	return SCIP_BRANCHED;
+}
+
+auto ExpertBranchingDynamics::reset_dynamics(scip::Model& model) -> std::tuple<bool, ActionSet> {
+	auto fcall = model.solve_iter(branchrule_constructor());
+	// Only LP branching pauses the solver, see branchrule_constructor.
+	if (fcall.has_value()) {
+		return {false, action_set(model)};
+	}
+	return {true, {}};
+}
+
+auto ExpertBranchingDynamics::step_dynamics(scip::Model& model, Action maybe_var_idx) -> std::tuple<bool, ActionSet> {
+	auto fcall = model.solve_iter_continue(branch(model, maybe_var_idx));
+	if (fcall.has_value()) {
+		return {false, action_set(model)};
+	}
+	evaluation.clear();
+	return {true, {}};
+}
+
+auto ExpertBranchingDynamics::solve_with_policy(scip::Model& model, Policy const& policy) -> void {
+	// Only called on LP branching, the other methods are filtered by the reverse branchrule.
+	model.solve_direct(branchrule_constructor(), [&](scip::callback::DynamicCall const& /*call*/) {
+		auto const maybe_action_set = action_set(model);
+		return branch(model, policy(model, maybe_action_set));
+	});
+	evaluation.clear();
+}
+
+}  // namespace ecole::dynamics
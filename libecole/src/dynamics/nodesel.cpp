@@ -79,9 +79,7 @@ auto NodeselDynamics::reset_dynamics(scip::Model& model) -> std::tuple<bool, Act
 	return {true, {}};
 }
 
-auto NodeselDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t> maybe_node_idx)
-	-> std::tuple<bool, ActionSet> {
-	auto scip_result = SCIP_DIDNOTRUN;
+auto NodeselDynamics::select_node(Defaultable<std::size_t> maybe_node_idx) -> SCIP_RESULT {
 	if (std::holds_alternative<std::size_t>(maybe_node_idx)) {
 		auto const node_idx = std::get<std::size_t>(maybe_node_idx);
 		auto iter = num_to_node.find(static_cast<SCIP_Longint>(node_idx));
@@ -89,9 +87,15 @@ auto NodeselDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t>
 		if (iter != num_to_node.end()) {
 			*(fcall.selnode) = iter->second;
 			// num_to_node.clear();
-			scip_result = SCIP_SUCCESS;
+			return SCIP_SUCCESS;
 		}
 	}
+	return SCIP_DIDNOTRUN;
+}
+
+auto NodeselDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t> maybe_node_idx)
+	-> std::tuple<bool, ActionSet> {
+	auto const scip_result = select_node(maybe_node_idx);
 
 	// resume scip's coro
 	auto maybe_fcall = model.solve_iter_continue(scip_result);
@@ -109,4 +113,16 @@ auto NodeselDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t>
 	return {true, {}};
 }
 
+auto NodeselDynamics::solve_with_policy(scip::Model& model, Policy const& policy) -> void {
+	model.solve_direct(scip::callback::NodeselConstructor{}, [&](scip::callback::DynamicCall const& call) {
+		fcall = std::get<scip::callback::NodeselCall>(call);
+		if (SCIPgetNNodesLeft(model.get_scip_ptr()) == 0) {
+			*(fcall.selnode) = nullptr;
+			return SCIP_DIDNOTRUN;
+		}
+		auto const nodes = action_set(model);
+		return select_node(policy(model, nodes));
+	});
+}
+
 }  // namespace ecole::dynamics
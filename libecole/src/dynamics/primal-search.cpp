@@ -49,26 +49,8 @@ auto add_solution_from_lp(SCIP* scip) -> bool {
 	return solution_kept;
 }
 
-}  // namespace
-
-auto PrimalSearchDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
-	if (trials_per_node == 0) {
-		model.solve();
-		return {true, {}};
-	}
-	auto const args = scip::callback::HeuristicConstructor{
-		scip::callback::priority_max,
-		depth_freq,
-		depth_start,
-		depth_stop,
-	};
-	if (model.solve_iter(args).has_value()) {
-		return {false, action_set(model)};
-	}
-	return {true, {}};
-}
-
-auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> std::tuple<bool, ActionSet> {
+/** Run a search trial from the (partial) solution given in the action, returning whether a solution was found. */
+auto search_trial(scip::Model& model, PrimalSearchDynamics::Action action) -> bool {
 	auto const [var_indices, vals] = action;
 	auto problem_vars = model.variables();
 
@@ -126,6 +108,32 @@ auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> s
 		scip::call(SCIPendProbing, scip_ptr);
 	}
 
+	return solution_kept;
+}
+
+}  // namespace
+
+auto PrimalSearchDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
+	if (trials_per_node == 0) {
+		model.solve();
+		return {true, {}};
+	}
+	auto const args = scip::callback::HeuristicConstructor{
+		scip::callback::priority_max,
+		depth_freq,
+		depth_start,
+		depth_stop,
+	};
+	if (model.solve_iter(args).has_value()) {
+		return {false, action_set(model)};
+	}
+	return {true, {}};
+}
+
+auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> std::tuple<bool, ActionSet> {
+	auto* const scip_ptr = model.get_scip_ptr();
+	auto const solution_kept = search_trial(model, action);
+
 	// update the final search result depending on the action result
 	if (solution_kept) {
 		result = SCIP_FOUNDSOL;
@@ -150,4 +158,30 @@ auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> s
 	return {false, action_set(model)};
 }
 
+auto PrimalSearchDynamics::solve_with_policy(scip::Model& model, Policy const& policy) const -> void {
+	if (trials_per_node == 0) {
+		model.solve();
+		return;
+	}
+	auto const args = scip::callback::HeuristicConstructor{
+		scip::callback::priority_max,
+		depth_freq,
+		depth_start,
+		depth_stop,
+	};
+	model.solve_direct(args, [&](scip::callback::DynamicCall const& /*call*/) {
+		auto* const scip_ptr = model.get_scip_ptr();
+		auto search_result = SCIP_DIDNOTFIND;
+		auto trials = 0U;
+		// Same stopping criteria as in step_dynamics
+		do {
+			if (search_trial(model, policy(model, action_set(model)))) {
+				search_result = SCIP_FOUNDSOL;
+			}
+			trials++;
+		} while ((trials != static_cast<unsigned int>(trials_per_node)) && !SCIPisStopped(scip_ptr));
+		return search_result;
+	});
+}
+
 }  // namespace ecole::dynamics
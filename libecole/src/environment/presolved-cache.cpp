@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+#include "ecole/environment/presolved-cache.hpp"
+
+namespace ecole::environment {
+
+namespace {
+
+/** Keep only the parameters that may change the presolved problem. */
+auto presolve_params(std::map<std::string, scip::Param> const& params) -> std::map<std::string, scip::Param> {
+	auto filtered = std::map<std::string, scip::Param>{};
+	std::copy_if(params.begin(), params.end(), std::inserter(filtered, filtered.end()), [](auto const& name_val) {
+		return PresolvedCache::is_presolve_param(name_val.first);
+	});
+	return filtered;
+}
+
+/** Boost hash_combine. */
+auto hash_combine(std::size_t seed, std::size_t hash) noexcept -> std::size_t {
+	return seed ^ (hash + 0x9e3779b9 + (seed << 6U) + (seed >> 2U));
+}
+
+}  // namespace
+
+auto PresolvedCache::Statistics::hit_rate() const noexcept -> double {
+	auto const n_total = n_hits + n_misses;
+	return n_total == 0 ? 0. : static_cast<double>(n_hits) / static_cast<double>(n_total);
+}
+
+auto PresolvedCache::Statistics::mean_reset_time() const noexcept -> double {
+	auto const n_total = n_hit_resets + n_miss_resets;
+	return n_total == 0 ? 0. : (hits_reset_time + misses_reset_time) / static_cast<double>(n_total);
+}
+
+auto PresolvedCache::Key::operator<(Key const& other) const noexcept -> bool {
+	auto const as_tuple = [](Key const& key) {
+		return std::tie(key.filename, key.file_size, key.modification_time, key.params_hash, key.params);
+	};
+	return as_tuple(*this) < as_tuple(other);
+}
+
+PresolvedCache::PresolvedCache(std::size_t capacity) : m_capacity{capacity} {}
+
+auto PresolvedCache::get(std::string const& filename, std::map<std::string, scip::Param> const& params)
+	-> scip::Model {
+	return lookup(filename, params).model;
+}
+
+auto PresolvedCache::lookup(std::string const& filename, std::map<std::string, scip::Param> const& params)
+	-> Lookup {
+	auto key = make_key(filename, params);
+
+	auto the_template = std::shared_ptr<Template const>{};
+	{
+		auto const lk = std::lock_guard{m_mutex};
+		if (auto iter = m_templates.find(key); iter != m_templates.end()) {
+			the_template = iter->second;
+		}
+	}
+	auto const hit = the_template != nullptr;
+
+	// Presolving is done without holding the lock so that other instances can be served meanwhile.
+	if (!hit) {
+		the_template = make_template(filename, params);
+		auto const lk = std::lock_guard{m_mutex};
+		if (m_capacity > 0 && m_templates.count(key) == 0) {
+			if (m_templates.size() >= m_capacity) {
+				m_templates.erase(m_insertion_order.front());
+				m_insertion_order.pop_front();
+			}
+			m_insertion_order.push_back(key);
+			m_templates.emplace(std::move(key), the_template);
+		}
+	}
+
+	// The template is not modified so it can be copied without holding the lock.
+	auto model = copy_template(*the_template);
+	// The template only has the parameters relevant to presolving.
+	model.set_params(params);
+
+	auto const lk = std::lock_guard{m_mutex};
+	if (hit) {
+		++m_statistics.n_hits;
+	} else {
+		++m_statistics.n_misses;
+	}
+	return {std::move(model), hit};
+}
+
+auto PresolvedCache::record_reset(bool hit, double seconds) -> void {
+	auto const lk = std::lock_guard{m_mutex};
+	if (hit) {
+		++m_statistics.n_hit_resets;
+		m_statistics.hits_reset_time += seconds;
+	} else {
+		++m_statistics.n_miss_resets;
+		m_statistics.misses_reset_time += seconds;
+	}
+}
+
+auto PresolvedCache::is_presolve_param(std::string const& name) -> bool {
+	static auto constexpr prefixes = std::array<std::string_view, 8>{
+		"constraints/",
+		"limits/",
+		"misc/",
+		"numerics/",
+		"presolving/",
+		"propagating/",
+		"randomization/",
+		"reading/",
+	};
+	return std::any_of(prefixes.begin(), prefixes.end(), [&name](auto prefix) {
+		return std::string_view{name}.substr(0, prefix.size()) == prefix;
+	});
+}
+
+auto PresolvedCache::statistics() const -> Statistics {
+	auto const lk = std::lock_guard{m_mutex};
+	return m_statistics;
+}
+
+auto PresolvedCache::size() const -> std::size_t {
+	auto const lk = std::lock_guard{m_mutex};
+	return m_templates.size();
+}
+
+auto PresolvedCache::clear() -> void {
+	auto const lk = std::lock_guard{m_mutex};
+	m_templates.clear();
+	m_insertion_order.clear();
+}
+
+auto PresolvedCache::make_key(std::string const& filename, std::map<std::string, scip::Param> const& params) -> Key {
+	// Errors are left to reading the file, a missing file is simply never found in the cache.
+	auto error = std::error_code{};
+	auto const file_size = std::filesystem::file_size(filename, error);
+	auto const modification_time = std::filesystem::last_write_time(filename, error);
+
+	auto key_params = presolve_params(params);
+	auto params_hash = std::size_t{0};
+	for (auto const& [name, value] : key_params) {
+		params_hash = hash_combine(params_hash, std::hash<std::string>{}(name));
+		params_hash = hash_combine(params_hash, std::hash<scip::Param>{}(value));
+	}
+	return {filename, file_size, modification_time, params_hash, std::move(key_params)};
+}
+
+auto PresolvedCache::make_template(std::string const& filename, std::map<std::string, scip::Param> const& params)
+	-> std::shared_ptr<Template const> {
+	auto const template_params = presolve_params(params);
+	auto model = scip::Model::from_file(filename);
+	model.set_params(template_params);
+	model.presolve();
+	// Presolving may solve the instance (e.g. by proving infeasibility), in which case the original problem is kept.
+	if (model.stage() != SCIP_STAGE_PRESOLVED) {
+		model = scip::Model::from_file(filename);
+		model.set_params(template_params);
+		return std::make_shared<Template const>(Template{std::move(model), false});
+	}
+	return std::make_shared<Template const>(Template{std::move(model), true});
+}
+
+auto PresolvedCache::copy_template(Template const& the_template) -> scip::Model {
+	// Copying the transformed problem makes the presolved problem the original problem of the copy.
+	return the_template.presolved ? the_template.model.copy() : the_template.model.copy_orig();
+}
+
+}  // namespace ecole::environment
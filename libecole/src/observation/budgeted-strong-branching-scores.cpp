@@ -0,0 +1,430 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <lpi/lpi.h>
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/data/concurrent.hpp"
+#include "ecole/data/step-context.hpp"
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "utility/lpi.hpp"
+
+namespace ecole::observation {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Deadline = std::optional<Clock::time_point>;
+
+auto is_past(Deadline const& deadline) -> bool {
+	return deadline.has_value() && (Clock::now() >= deadline.value());
+}
+
+/** Whether strong branching can be done on a variable, i.e. it is a column of the current LP. */
+auto is_in_lp(SCIP_VAR* const var) -> bool {
+	return (SCIPvarGetStatus(var) == SCIP_VARSTATUS_COLUMN) && SCIPcolIsInLP(SCIPvarGetCol(var));
+}
+
+/** The branching candidates with their pseudocost score, by decreasing score. */
+auto get_candidates(scip::Model& model, bool pseudo_candidates, data::StepContext& context)
+	-> std::vector<StrongBranchingCandidate> {
+	auto* const scip = model.get_scip_ptr();
+	auto const& cands = pseudo_candidates ? context.pseudo_branch_cands(model) : context.lp_branch_cands(model);
+	auto candidates = std::vector<StrongBranchingCandidate>(cands.variables.size());
+	for (std::size_t cand_idx = 0; cand_idx < candidates.size(); ++cand_idx) {
+		auto& cand = candidates[cand_idx];
+		cand.variable = cands.variables[cand_idx];
+		cand.lp_value = cands.lp_values.empty() ? SCIPvarGetLPSol(cand.variable) : cands.lp_values[cand_idx];
+		cand.score = SCIPgetVarPseudocostScore(scip, cand.variable, cand.lp_value);
+	}
+	std::stable_sort(candidates.begin(), candidates.end(), [](auto const& cand1, auto const& cand2) {
+		return cand1.score > cand2.score;
+	});
+	return candidates;
+}
+
+/** Evaluate the candidates in order with SCIP strong branching, until the deadline. */
+void evaluate_in_scip(
+	SCIP* const scip,
+	nonstd::span<StrongBranchingCandidate> candidates,
+	std::optional<int> iteration_limit,
+	Deadline const& deadline) {
+	auto const itlim = iteration_limit.value_or(INT_MAX);
+	scip::call(SCIPstartStrongbranch, scip, false);
+	for (auto& cand : candidates) {
+		if (is_past(deadline)) {
+			break;
+		}
+		if (!is_in_lp(cand.variable)) {
+			continue;
+		}
+		SCIP_Real down = 0.;
+		SCIP_Real up = 0.;
+		SCIP_Bool down_valid = false;
+		SCIP_Bool up_valid = false;
+		SCIP_Bool down_infeasible = false;
+		SCIP_Bool up_infeasible = false;
+		SCIP_Bool lp_error = false;
+		auto const n_iterations = SCIPgetNStrongbranchLPIterations(scip);
+		// Same choice of method as the vanillafullstrong branching rule
+		auto* const strong_branch =
+			SCIPisFeasIntegral(scip, cand.lp_value) ? &SCIPgetVarStrongbranchInt : &SCIPgetVarStrongbranchFrac;
+		scip::call(
+			strong_branch,
+			scip,
+			cand.variable,
+			itlim,
+			true,
+			&down,
+			&up,
+			&down_valid,
+			&up_valid,
+			&down_infeasible,
+			&up_infeasible,
+			nullptr,
+			nullptr,
+			&lp_error);
+		if (lp_error) {
+			break;
+		}
+		// Both children share the iteration count, so the flag is conservative
+		auto const within_limit =
+			!iteration_limit.has_value() || (SCIPgetNStrongbranchLPIterations(scip) - n_iterations < itlim);
+		cand.evaluated = true;
+		cand.exact = down_valid && up_valid && within_limit;
+		// Values that are not valid dual bounds fall back to the bound of the node
+		cand.down_bound = down_valid ? down : SCIPgetLPObjval(scip);
+		cand.up_bound = up_valid ? up : SCIPgetLPObjval(scip);
+		cand.down_infeasible = down_infeasible;
+		cand.up_infeasible = up_infeasible;
+	}
+	scip::call(SCIPendStrongbranch, scip);
+}
+
+/** The current LP of SCIP as arrays, with infinite values as std::numeric_limits infinity. */
+struct LpData {
+	std::vector<SCIP_Real> objs;
+	std::vector<SCIP_Real> lbs;
+	std::vector<SCIP_Real> ubs;
+	std::vector<SCIP_Real> lhss;
+	std::vector<SCIP_Real> rhss;
+	std::vector<int> begs;
+	std::vector<int> inds;
+	std::vector<SCIP_Real> vals;
+	std::vector<int> col_basis;
+	std::vector<int> row_basis;
+};
+
+auto get_lp_data(scip::Model& model) -> LpData {
+	auto* const scip = model.get_scip_ptr();
+	auto const to_data_value = [scip](SCIP_Real val) {
+		auto constexpr infinity = std::numeric_limits<SCIP_Real>::infinity();
+		if (SCIPisInfinity(scip, val)) {
+			return infinity;
+		}
+		return SCIPisInfinity(scip, -val) ? -infinity : val;
+	};
+
+	auto data = LpData{};
+	for (auto* const col : model.lp_columns()) {
+		data.objs.push_back(SCIPcolGetObj(col));
+		data.lbs.push_back(to_data_value(SCIPcolGetLb(col)));
+		data.ubs.push_back(to_data_value(SCIPcolGetUb(col)));
+		data.col_basis.push_back(static_cast<int>(SCIPcolGetBasisStatus(col)));
+	}
+	for (auto* const row : model.lp_rows()) {
+		// Infinite sides stay infinite when removing the constant
+		auto const constant = SCIProwGetConstant(row);
+		data.lhss.push_back(to_data_value(SCIProwGetLhs(row)) - constant);
+		data.rhss.push_back(to_data_value(SCIProwGetRhs(row)) - constant);
+		data.begs.push_back(static_cast<int>(data.inds.size()));
+		auto* const row_cols = SCIProwGetCols(row);
+		auto const* const row_vals = SCIProwGetVals(row);
+		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			data.inds.push_back(SCIPcolGetLPPos(row_cols[k]));
+			data.vals.push_back(row_vals[k]);
+		}
+		data.row_basis.push_back(static_cast<int>(SCIProwGetBasisStatus(row)));
+	}
+	return data;
+}
+
+/** A copy of the LP in its own LP solver interface, which can be solved independently of SCIP. */
+class LpCopy {
+public:
+	LpCopy(SCIP_MESSAGEHDLR* messagehdlr, LpData const& data_) : data{data_} {
+		SCIP_LPI* lpi_ptr = nullptr;
+		scip::call(SCIPlpiCreate, &lpi_ptr, messagehdlr, "strongbranching", SCIP_OBJSEN_MINIMIZE);
+		lpi = utility::unique_lpi{lpi_ptr};
+		auto const lbs = to_lpi_values(data.lbs);
+		auto const ubs = to_lpi_values(data.ubs);
+		scip::call(
+			SCIPlpiAddCols,
+			lpi.get(),
+			static_cast<int>(data.objs.size()),
+			data.objs.data(),
+			lbs.data(),
+			ubs.data(),
+			nullptr,
+			0,
+			nullptr,
+			nullptr,
+			nullptr);
+		if (!data.lhss.empty()) {
+			auto const lhss = to_lpi_values(data.lhss);
+			auto const rhss = to_lpi_values(data.rhss);
+			scip::call(
+				SCIPlpiAddRows,
+				lpi.get(),
+				static_cast<int>(data.lhss.size()),
+				lhss.data(),
+				rhss.data(),
+				nullptr,
+				static_cast<int>(data.inds.size()),
+				data.begs.data(),
+				data.inds.data(),
+				data.vals.data());
+		}
+	}
+
+	/** Solve the LP from the basis of SCIP, return its objective value if optimal. */
+	auto solve() -> std::optional<SCIP_Real> {
+		scip::call(SCIPlpiSetBase, lpi.get(), data.col_basis.data(), data.row_basis.data());
+		scip::call(SCIPlpiSolveDual, lpi.get());
+		if (!SCIPlpiIsOptimal(lpi.get())) {
+			return {};
+		}
+		return objective();
+	}
+
+	/** Outcome of solving the LP with the bounds of a column changed. */
+	struct Child {
+		SCIP_Real objective = 0.;
+		bool infeasible = false;
+		bool exact = false;
+	};
+
+	/**
+	 * Solve the LP with different bounds for a column, warm started from the basis of SCIP.
+	 *
+	 * The LP is left unchanged.
+	 * When the child is not solved exactly, its objective is the last dual bound, or the given fallback if the solver
+	 * does not provide one.
+	 */
+	auto solve_child(int col, SCIP_Real lb, SCIP_Real ub, int iteration_limit, SCIP_Real fallback) -> Child {
+		auto const col_idx = static_cast<std::size_t>(col);
+		lb = std::max(lb, data.lbs[col_idx]);
+		ub = std::min(ub, data.ubs[col_idx]);
+		if (lb > ub) {
+			return {0., true, true};
+		}
+
+		auto const lpi_lb = to_lpi_value(lb);
+		auto const lpi_ub = to_lpi_value(ub);
+		scip::call(SCIPlpiSetIntpar, lpi.get(), SCIP_LPPAR_LPITLIM, iteration_limit);
+		scip::call(SCIPlpiChgBounds, lpi.get(), 1, &col, &lpi_lb, &lpi_ub);
+		scip::call(SCIPlpiSetBase, lpi.get(), data.col_basis.data(), data.row_basis.data());
+		auto child = Child{fallback, false, false};
+		if (SCIPlpiSolveDual(lpi.get()) == SCIP_OKAY) {
+			if (SCIPlpiIsOptimal(lpi.get())) {
+				child = {objective(), false, true};
+			} else if (SCIPlpiIsPrimalInfeasible(lpi.get()) || SCIPlpiIsObjlimExc(lpi.get())) {
+				child = {fallback, true, true};
+			} else if (SCIPlpiIsDualFeasible(lpi.get())) {
+				child.objective = std::max(objective(), fallback);
+			}
+		}
+		auto const orig_lb = to_lpi_value(data.lbs[col_idx]);
+		auto const orig_ub = to_lpi_value(data.ubs[col_idx]);
+		scip::call(SCIPlpiChgBounds, lpi.get(), 1, &col, &orig_lb, &orig_ub);
+		return child;
+	}
+
+private:
+	LpData const& data;
+	utility::unique_lpi lpi;
+
+	[[nodiscard]] auto objective() -> SCIP_Real {
+		SCIP_Real obj = 0.;
+		scip::call(SCIPlpiGetObjval, lpi.get(), &obj);
+		return obj;
+	}
+
+	[[nodiscard]] auto to_lpi_value(SCIP_Real val) const -> SCIP_Real {
+		return std::isinf(val) ? std::copysign(SCIPlpiInfinity(lpi.get()), val) : val;
+	}
+
+	[[nodiscard]] auto to_lpi_values(std::vector<SCIP_Real> const& vals) const -> std::vector<SCIP_Real> {
+		auto lpi_vals = std::vector<SCIP_Real>(vals.size());
+		std::transform(vals.begin(), vals.end(), lpi_vals.begin(), [this](auto val) { return to_lpi_value(val); });
+		return lpi_vals;
+	}
+};
+
+/**
+ * Evaluate the candidates on independent copies of the current LP, one per thread.
+ *
+ * Threads take the next candidate in order until the deadline.
+ * Only the calling thread queries SCIP, before and after the concurrent evaluation.
+ */
+void evaluate_on_lp_copies(
+	scip::Model& model,
+	nonstd::span<StrongBranchingCandidate> candidates,
+	std::optional<int> iteration_limit,
+	Deadline const& deadline,
+	std::size_t n_threads) {
+	auto* const scip = model.get_scip_ptr();
+	auto const data = get_lp_data(model);
+	auto* const messagehdlr = SCIPgetMessagehdlr(scip);
+	auto const lp_obj = SCIPgetLPObjval(scip);
+	auto const cutoff = SCIPgetCutoffbound(scip);
+	auto const itlim = iteration_limit.value_or(INT_MAX);
+	// With columns missing from the LP (e.g. priced variables), the copy is a restriction of the real LP.
+	// Its children can then overestimate the real bound or be infeasible when the real ones are not, so nothing is
+	// proven, as with the downvalid and upvalid of SCIP strong branching.
+	auto const all_cols_in_lp = static_cast<bool>(SCIPallColsInLP(scip));
+
+	/** Column of each candidate in the LP (negative if none), and bound of its down and up children. */
+	struct Branching {
+		int col = -1;
+		SCIP_Real down_ub = 0.;
+		SCIP_Real up_lb = 0.;
+	};
+	auto branchings = std::vector<Branching>(candidates.size());
+	for (std::size_t cand_idx = 0; cand_idx < candidates.size(); ++cand_idx) {
+		auto const& cand = candidates[cand_idx];
+		if (is_in_lp(cand.variable)) {
+			branchings[cand_idx] = {
+				SCIPcolGetLPPos(SCIPvarGetCol(cand.variable)),
+				SCIPfeasCeil(scip, cand.lp_value - 1.),
+				SCIPfeasFloor(scip, cand.lp_value + 1.),
+			};
+		}
+	}
+
+	auto next_cand = std::atomic<std::size_t>{0};
+	auto tasks = std::vector<std::function<void()>>{};
+	tasks.reserve(n_threads);
+	for (std::size_t thread = 0; thread < n_threads; ++thread) {
+		tasks.emplace_back([&]() {
+			auto lp = LpCopy{messagehdlr, data};
+			auto const ref_obj = lp.solve();
+			if (!ref_obj.has_value()) {
+				return;
+			}
+			// Gains are relative to the copy, which leaves out the objective of the columns not in the LP
+			auto const to_bound = [&](LpCopy::Child const& child) {
+				return child.infeasible ? cutoff : lp_obj + (child.objective - ref_obj.value());
+			};
+			auto constexpr inf = std::numeric_limits<SCIP_Real>::infinity();
+			for (auto cand_idx = next_cand++; cand_idx < candidates.size(); cand_idx = next_cand++) {
+				if (is_past(deadline)) {
+					break;
+				}
+				auto const& branching = branchings[cand_idx];
+				if (branching.col < 0) {
+					continue;
+				}
+				auto const down = lp.solve_child(branching.col, -inf, branching.down_ub, itlim, ref_obj.value());
+				auto const up = lp.solve_child(branching.col, branching.up_lb, inf, itlim, ref_obj.value());
+				auto& cand = candidates[cand_idx];
+				cand.evaluated = true;
+				cand.exact = all_cols_in_lp && down.exact && up.exact;
+				cand.down_bound = to_bound(down);
+				cand.up_bound = to_bound(up);
+				cand.down_infeasible = all_cols_in_lp && down.infeasible;
+				cand.up_infeasible = all_cols_in_lp && up.infeasible;
+			}
+		});
+	}
+	data::internal::run_concurrently(tasks);
+}
+
+}  // namespace
+
+BudgetedStrongBranchingScores::BudgetedStrongBranchingScores(
+	bool pseudo_candidates_,
+	std::optional<int> iteration_limit_,
+	std::optional<double> time_limit_,
+	std::optional<std::size_t> top_k_,
+	std::size_t n_threads_) :
+	pseudo_candidates{pseudo_candidates_},
+	iteration_limit{iteration_limit_},
+	time_limit{time_limit_},
+	top_k{top_k_},
+	n_threads{n_threads_} {}
+
+auto BudgetedStrongBranchingScores::extract(scip::Model& model, bool done) const
+	-> std::optional<BudgetedStrongBranchingScoresObs> {
+	auto context = data::StepContext{};
+	return extract_in_context(model, done, context);
+}
+
+auto BudgetedStrongBranchingScores::extract_in_context(
+	scip::Model& model,
+	bool /* done */,
+	data::StepContext& context) const -> std::optional<BudgetedStrongBranchingScoresObs> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(model.get_scip_ptr()));
+	auto obs = BudgetedStrongBranchingScoresObs{
+		xt::xtensor<double, 1>({n_vars}, std::nan("")),
+		xt::xtensor<bool, 1>({n_vars}, false),
+	};
+	for (auto const& cand : evaluate(model, context)) {
+		auto const var_idx = static_cast<std::size_t>(SCIPvarGetProbindex(cand.variable));
+		obs.scores[var_idx] = static_cast<double>(cand.score);
+		obs.exact[var_idx] = cand.exact;
+	}
+	return obs;
+}
+
+auto BudgetedStrongBranchingScores::evaluate(scip::Model& model, data::StepContext& context) const
+	-> std::vector<StrongBranchingCandidate> {
+	auto* const scip = model.get_scip_ptr();
+	auto candidates = get_candidates(model, pseudo_candidates, context);
+	if (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) {
+		return candidates;
+	}
+
+	auto deadline = Deadline{};
+	if (time_limit.has_value()) {
+		auto const budget = std::chrono::duration<double>{time_limit.value()};
+		deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(budget);
+	}
+	auto const n_evaluated = std::min(candidates.size(), top_k.value_or(candidates.size()));
+	auto const to_evaluate = nonstd::span{candidates.data(), n_evaluated};
+	if (n_threads > 0) {
+		evaluate_on_lp_copies(model, to_evaluate, iteration_limit, deadline, n_threads);
+	} else {
+		evaluate_in_scip(scip, to_evaluate, iteration_limit, deadline);
+	}
+
+	auto const lp_obj = SCIPgetLPObjval(scip);
+	for (auto& cand : to_evaluate) {
+		if (cand.evaluated) {
+			auto const down_gain = std::max(cand.down_bound - lp_obj, 0.);
+			auto const up_gain = std::max(cand.up_bound - lp_obj, 0.);
+			cand.score = SCIPgetBranchScore(scip, cand.variable, down_gain, up_gain);
+		}
+	}
+	return candidates;
+}
+
+}  // namespace ecole::observation
@@ -1,27 +1,38 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <nonstd/span.hpp>
 #include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
+#include <lpi/lpi.h>
 #include <scip/scip.h>
 #include <xtensor/xadapt.hpp>
+#include <xtensor/xbuilder.hpp>
 #include <xtensor/xindex_view.hpp>
 #include <xtensor/xsort.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/hutter-2011.hpp"
+#include "ecole/random.hpp"
 #include "ecole/scip/cons.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
 
-#include "utility/graph.hpp"
+#include "utility/csr-graph.hpp"
+#include "utility/lpi.hpp"
 #include "utility/math.hpp"
 
 namespace ecole::observation {
@@ -124,120 +135,462 @@ template <typename E, typename QT, std::size_t QN> auto quantiles(E&& data, std:
 	return quants;
 }
 
-/** [12-17,20] Variable graph features. */
-template <typename Tensor> void set_var_degrees(Tensor&& out, ConstraintMatrix const& matrix) {
-	auto const n_var = matrix.shape[var_axis];
-	auto const n_cons = matrix.shape[cons_axis];
-	// Build variable graph.
-	// TODO could be optimized if we know matrix.indices[cons_axis] is sorted (or sort it).
-	auto graph = utility::Graph{n_var};
-	for (std::size_t cons = 0; cons < n_cons; ++cons) {
-		auto const vars =
-			xt::eval(xt::filter(xt::row(matrix.indices, var_axis), xt::equal(xt::row(matrix.indices, cons_axis), cons)));
-		auto const* const var_end = vars.end();
-		for (auto const* var1_iter = vars.begin(); var1_iter < var_end; ++var1_iter) {
-			for (auto const* var2_iter = var1_iter + 1; var2_iter < var_end; ++var2_iter) {
-				if (!graph.are_connected(*var1_iter, *var2_iter)) {
-					graph.add_edge({*var1_iter, *var2_iter});
-				}
+/** Group the variables by constraint, from which the variable graph is built. */
+auto get_var_incidence(ConstraintMatrix const& matrix) {
+	auto const nnz = matrix.nnz();
+	auto const* const indices = matrix.indices.data();
+	return utility::GroupIncidence{
+		matrix.shape[var_axis],
+		matrix.shape[cons_axis],
+		{indices + cons_axis * nnz, nnz},
+		{indices + var_axis * nnz, nnz},
+	};
+}
+
+/** Number of pairs of neighbours sampled to estimate the local clustering coefficient of a variable. */
+std::size_t constexpr n_wedge_samples = 64;
+
+/** Local clustering coefficient of a node, with the variance of its estimate. */
+struct ClusteringEstimate {
+	value_type coef = 0.;
+	value_type variance = 0.;
+	bool exact = true;
+};
+
+/**
+ * Estimate the local clustering coefficient of a node, the fraction of pairs of its neighbours that are connected.
+ *
+ * All pairs are checked if there are at most n_wedge_samples of them, otherwise n_wedge_samples pairs are sampled
+ * with replacement.
+ */
+template <typename AreConnected>
+auto local_clustering(
+	nonstd::span<std::size_t const> neighbors,
+	AreConnected&& are_connected,
+	RandomGenerator& rng) -> ClusteringEstimate {
+	auto const degree = neighbors.size();
+	if (degree < 2) {
+		return {};
+	}
+
+	auto n_connected = std::size_t{0};
+	auto const n_pairs = degree * (degree - 1) / 2;
+	if (n_pairs <= n_wedge_samples) {
+		for (std::size_t i = 0; i < degree; ++i) {
+			for (auto j = i + 1; j < degree; ++j) {
+				n_connected += are_connected(neighbors[i], neighbors[j]) ? 1 : 0;
 			}
 		}
+		return {static_cast<value_type>(n_connected) / static_cast<value_type>(n_pairs), 0., true};
+	}
+
+	auto choose_first = std::uniform_int_distribution<std::size_t>{0, degree - 1};
+	auto choose_second = std::uniform_int_distribution<std::size_t>{0, degree - 2};
+	for (std::size_t k = 0; k < n_wedge_samples; ++k) {
+		auto const i = choose_first(rng);
+		auto j = choose_second(rng);
+		j += (j >= i) ? 1 : 0;
+		n_connected += are_connected(neighbors[i], neighbors[j]) ? 1 : 0;
+	}
+	auto const n_wedges = static_cast<value_type>(n_wedge_samples);
+	auto const coef = static_cast<value_type>(n_connected) / n_wedges;
+	return {coef, coef * (1. - coef) / n_wedges, false};
+}
+
+/** Degrees and local clustering coefficients of some variables in the variable graph. */
+struct VarGraphSample {
+	std::vector<std::size_t> degrees;
+	std::vector<value_type> clustering;
+	std::vector<value_type> clustering_variances;
+	bool exact_clustering = true;
+
+	auto push_back(std::size_t degree, ClusteringEstimate const& estimate) {
+		degrees.push_back(degree);
+		clustering.push_back(estimate.coef);
+		clustering_variances.push_back(estimate.variance);
+		exact_clustering = exact_clustering && estimate.exact;
+	}
+};
+
+/**
+ * Variable graph statistics of all variables, from the materialized variable graph.
+ *
+ * The clustering coefficients are computed exactly by counting triangles, unless it exceeds the triangle budget, in
+ * which case they are estimated by sampling pairs of neighbours.
+ */
+auto sample_var_graph(
+	utility::CsrGraph const& graph,
+	std::optional<std::size_t> triangle_budget,
+	RandomGenerator& rng) -> VarGraphSample {
+	auto const n_var = graph.n_nodes();
+	auto sample = VarGraphSample{};
+	sample.degrees.reserve(n_var);
+	sample.clustering.reserve(n_var);
+	sample.clustering_variances.reserve(n_var);
+
+	if (!triangle_budget.has_value() || (graph.triangle_work() <= triangle_budget.value())) {
+		auto const triangles = graph.triangle_counts();
+		for (std::size_t var = 0; var < n_var; ++var) {
+			auto const degree = graph.degree(var);
+			auto const n_pairs = static_cast<value_type>(degree * (degree - 1) / 2);
+			auto const coef = degree > 1 ? static_cast<value_type>(triangles[var]) / n_pairs : 0.;
+			sample.push_back(degree, {coef, 0., true});
+		}
+	} else {
+		auto are_connected = [&graph](auto var1, auto var2) { return graph.are_connected(var1, var2); };
+		for (std::size_t var = 0; var < n_var; ++var) {
+			sample.push_back(graph.degree(var), local_clustering(graph.neighbors(var), are_connected, rng));
+		}
+	}
+	return sample;
+}
+
+/** Variable graph statistics of the given variables, computed without materializing the variable graph. */
+auto sample_var_graph(
+	utility::GroupIncidence const& incidence,
+	std::vector<std::size_t> const& variables,
+	RandomGenerator& rng) -> VarGraphSample {
+	auto sample = VarGraphSample{};
+	auto marker = std::vector<std::size_t>(incidence.n_nodes(), incidence.n_nodes());
+	auto neighbors = std::vector<std::size_t>{};
+	auto are_connected = [&incidence](auto var1, auto var2) { return incidence.share_group(var1, var2); };
+	for (auto const var : variables) {
+		incidence.expansion_neighbors(var, marker, neighbors);
+		sample.push_back(neighbors.size(), local_clustering(neighbors, are_connected, rng));
 	}
+	return sample;
+}
+
+/**
+ * Sample variables without replacement.
+ *
+ * Selection sampling keeps the variables sorted, which makes visiting their neighbours more cache friendly.
+ * At least two variables are sampled, as needed to estimate a standard deviation.
+ */
+auto sample_variables(std::size_t n_var, std::size_t n_samples, RandomGenerator& rng) {
+	n_samples = std::max(n_samples, std::size_t{2});
+	auto variables = std::vector<std::size_t>(n_var);
+	std::iota(variables.begin(), variables.end(), std::size_t{0});
+	if (n_samples >= n_var) {
+		return variables;
+	}
+	auto sample = std::vector<std::size_t>{};
+	sample.reserve(n_samples);
+	std::sample(variables.begin(), variables.end(), std::back_inserter(sample), n_samples, rng);
+	return sample;
+}
 
-	// Compute stats
-	auto get_var_degree = [&graph](auto var) { return graph.neighbors(var).size(); };
-	auto var_degrees = views::ints(0UL, n_var) | views::transform(get_var_degree) | ranges::to<std::vector>();
+/**
+ * Standard error of the mean of a value over all nodes, estimated in two stages.
+ *
+ * The value is estimated on n_samples out of n_total nodes, with the given variance between nodes, and the given
+ * mean variance of the estimate of each node (zero when they are exact).
+ */
+auto mean_standard_error(
+	value_type between_variance,
+	value_type within_variance,
+	std::size_t n_samples,
+	std::size_t n_total) -> value_type {
+	auto const fraction = static_cast<value_type>(n_samples) / static_cast<value_type>(n_total);
+	auto const variance = (1. - fraction) * between_variance + fraction * within_variance;
+	return std::sqrt(variance / static_cast<value_type>(n_samples));
+}
+
+/** Unbiased variance of a sample from its (biased) standard deviation. */
+auto sample_variance(value_type stddev, std::size_t n_samples) -> value_type {
+	auto const n = static_cast<value_type>(n_samples);
+	return n_samples > 1 ? utility::square(stddev) * n / (n - 1.) : 0.;
+}
 
-	auto const stats = utility::compute_stats(var_degrees);
-	out[idx(Features::node_degree_mean)] = stats.mean;
-	out[idx(Features::node_degree_max)] = stats.max;
-	out[idx(Features::node_degree_min)] = stats.min;
-	out[idx(Features::node_degree_std)] = stats.stddev;
-	auto const quants = quantiles(xt::adapt(var_degrees), std::array<double, 2>{0.25, 0.75});
+/**
+ * [12-20] Variable graph features.
+ *
+ * When the sample does not include all variables, or the clustering coefficients are estimated, the standard errors
+ * of the features are set in errors.
+ * Extreme values, quantiles, and the standard deviation of estimated clustering coefficients have no simple error
+ * estimate and are set to NaN.
+ */
+template <typename Tensor, typename ErrorTensor>
+void set_var_graph_features(Tensor&& out, ErrorTensor&& errors, VarGraphSample const& sample, std::size_t n_var) {
+	auto const degree_stats = utility::compute_stats(sample.degrees);
+	out[idx(Features::node_degree_mean)] = degree_stats.mean;
+	out[idx(Features::node_degree_max)] = degree_stats.max;
+	out[idx(Features::node_degree_min)] = degree_stats.min;
+	out[idx(Features::node_degree_std)] = degree_stats.stddev;
+	auto const quants = quantiles(xt::adapt(sample.degrees), std::array<double, 2>{0.25, 0.75});
 	out[idx(Features::node_degree_25q)] = quants[0];
 	out[idx(Features::node_degree_75q)] = quants[1];
-	auto const n_edges_complete_graph = static_cast<value_type>(n_var * (n_var - 1)) / 2.;
-	out[idx(Features::edge_density)] = static_cast<value_type>(graph.n_edges()) / n_edges_complete_graph;
+	// The sum of degrees is twice the number of edges, hence the density is the mean degree over n_var - 1.
+	auto const max_degree = n_var > 1 ? static_cast<value_type>(n_var - 1) : 1.;
+	out[idx(Features::edge_density)] = degree_stats.mean / max_degree;
+	auto const clustering_stats = utility::compute_stats(sample.clustering);
+	out[idx(Features::clustering_coef_mean)] = clustering_stats.mean;
+	out[idx(Features::clustering_coef_std)] = clustering_stats.stddev;
+
+	auto const n_samples = sample.degrees.size();
+	auto constexpr unknown = std::numeric_limits<value_type>::quiet_NaN();
+	if (n_samples < n_var) {
+		assert(n_samples > 1);
+		auto const degree_variance = sample_variance(degree_stats.stddev, n_samples);
+		auto const mean_error = mean_standard_error(degree_variance, 0., n_samples, n_var);
+		// Normal approximation of the standard error of the standard deviation.
+		auto const fraction = static_cast<value_type>(n_samples) / static_cast<value_type>(n_var);
+		auto const std_error =
+			std::sqrt((1. - fraction) * degree_variance / (2. * (static_cast<value_type>(n_samples) - 1.)));
+		errors[idx(Features::node_degree_mean)] = mean_error;
+		errors[idx(Features::node_degree_std)] = std_error;
+		errors[idx(Features::edge_density)] = mean_error / max_degree;
+		errors[idx(Features::node_degree_max)] = unknown;
+		errors[idx(Features::node_degree_min)] = unknown;
+		errors[idx(Features::node_degree_25q)] = unknown;
+		errors[idx(Features::node_degree_75q)] = unknown;
+	}
+	if ((n_samples < n_var) || !sample.exact_clustering) {
+		auto const within_variance = utility::compute_stats(sample.clustering_variances).mean;
+		auto const between_variance = sample_variance(clustering_stats.stddev, n_samples);
+		errors[idx(Features::clustering_coef_mean)] =
+			mean_standard_error(between_variance, within_variance, n_samples, n_var);
+		errors[idx(Features::clustering_coef_std)] = unknown;
+	}
+}
+
+/** Whether the variables of the model are in the original space, rather than the transformed (minimization) space. */
+auto in_original_space(SCIP* scip) {
+	return SCIPgetStage(scip) == SCIP_STAGE_PROBLEM;
 }
 
-/** Solves the LP relaxation of a model by making a copy, and setting all its variables continuous. */
-auto solve_lp_relaxation(scip::Model const& model) {
-	auto relax_model = model.copy();
-	auto* const relax_scip = relax_model.get_scip_ptr();
-	auto const variables = relax_model.variables();
-
-	// Change active variables to continuous
-	for (auto* const var : variables) {
-		SCIP_Bool infeasible = FALSE;
-		scip::call(SCIPchgVarType, relax_scip, var, SCIP_VARTYPE_CONTINUOUS, &infeasible);
-		assert(!infeasible);
+/** Objective value of the LP relaxation, and the value of each variable in its optimal solution. */
+struct LpSolution {
+	/** In the original space, infinite if the LP is infeasible or unbounded, and NaN if it could not be solved. */
+	SCIP_Real objective = std::numeric_limits<SCIP_Real>::quiet_NaN();
+	/** Empty unless the LP is solved to optimality. */
+	std::vector<SCIP_Real> values;
+	bool optimal = false;
+};
+
+/**
+ * Solve the LP relaxation of a model directly in an LP solver interface.
+ *
+ * The rows are the linear constraints of the constraint matrix, and the columns are the variables with their global
+ * bounds.
+ * Unlike solving a copy of the model with all variables made continuous, no second SCIP instance, presolving, or
+ * plugins are involved.
+ *
+ * @return The solution, with the objective value in the original space.
+ */
+auto solve_lp_relaxation(
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases) -> LpSolution {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	auto const variables = model.variables();
+	auto const n_var = variables.size();
+	auto const n_rows = cons_matrix.shape[cons_axis];
+	auto const maximize = in_original_space(scip) && (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MAXIMIZE);
+
+	auto const lpi = [&] {
+		SCIP_LPI* lpi_ptr = nullptr;
+		auto const objsen = maximize ? SCIP_OBJSEN_MAXIMIZE : SCIP_OBJSEN_MINIMIZE;
+		scip::call(SCIPlpiCreate, &lpi_ptr, SCIPgetMessagehdlr(scip), "hutter2011", objsen);
+		return utility::unique_lpi{lpi_ptr};
+	}();
+	auto const infinity = SCIPlpiInfinity(lpi.get());
+	auto const to_lpi_value = [&](SCIP_Real val) {
+		if (SCIPisInfinity(scip, val)) {
+			return infinity;
+		}
+		return SCIPisInfinity(scip, -val) ? -infinity : val;
+	};
+
+	{  // Add the variables as columns, without coefficients
+		auto objs = std::vector<SCIP_Real>(n_var);
+		auto lbs = std::vector<SCIP_Real>(n_var);
+		auto ubs = std::vector<SCIP_Real>(n_var);
+		for (std::size_t var_idx = 0; var_idx < n_var; ++var_idx) {
+			objs[var_idx] = SCIPvarGetObj(variables[var_idx]);
+			lbs[var_idx] = to_lpi_value(SCIPvarGetLbGlobal(variables[var_idx]));
+			ubs[var_idx] = to_lpi_value(SCIPvarGetUbGlobal(variables[var_idx]));
+		}
+		scip::call(
+			SCIPlpiAddCols,
+			lpi.get(),
+			static_cast<int>(n_var),
+			objs.data(),
+			lbs.data(),
+			ubs.data(),
+			nullptr,
+			0,
+			nullptr,
+			nullptr,
+			nullptr);
 	}
 
-	// Change constraint variables to continuous
-	for (auto* const constraint : relax_model.constraints()) {
-		auto const cons_vars = scip::get_cons_vars(relax_scip, constraint);
-		assert(cons_vars.has_value());
-		for (auto* const var : cons_vars.value()) {
-			SCIP_Bool infeasible = FALSE;
-			scip::call(SCIPchgVarType, relax_scip, var, SCIP_VARTYPE_CONTINUOUS, &infeasible);
-			assert(!infeasible);
+	if (n_rows > 0) {  // Add the constraints as rows Ax <= b
+		auto csr = utility::csr_matrix<SCIP_Real>{};
+		utility::coo_to_csr(cons_matrix, csr);
+		auto const to_int = [](auto idx) { return static_cast<int>(idx); };
+		auto begs = std::vector<int>(n_rows);
+		for (std::size_t row = 0; row < n_rows; ++row) {
+			begs[row] = to_int(csr.indptr[row]);
 		}
+		auto inds = std::vector<int>(csr.nnz());
+		std::transform(csr.indices.begin(), csr.indices.end(), inds.begin(), to_int);
+		auto const lhss = std::vector<SCIP_Real>(n_rows, -infinity);
+		auto rhss = std::vector<SCIP_Real>(n_rows);
+		std::transform(cons_biases.begin(), cons_biases.end(), rhss.begin(), to_lpi_value);
+		scip::call(
+			SCIPlpiAddRows,
+			lpi.get(),
+			static_cast<int>(n_rows),
+			lhss.data(),
+			rhss.data(),
+			nullptr,
+			static_cast<int>(csr.nnz()),
+			begs.data(),
+			inds.data(),
+			csr.values.data());
 	}
 
-	// Solve the LP
-	scip::call(SCIPsolve, relax_scip);
-
-	// Collect the solution
-	// Note: technically this is the solution with respect to the copy model's active variables
-	// Hopefully this should match 1-1 the original model's active variables?
-	SCIP_SOL* optimal_sol = SCIPgetBestSol(relax_scip);
-	SCIP_Real optimal_value = SCIPgetSolOrigObj(relax_scip, optimal_sol);
-	auto optimal_sol_coefs = std::vector<SCIP_Real>(variables.size());
-	scip::call(
-		SCIPgetSolVals,
-		relax_scip,
-		optimal_sol,
-		static_cast<int>(variables.size()),
-		variables.data(),
-		optimal_sol_coefs.data());
-
-	return std::tuple{std::move(optimal_sol_coefs), optimal_value};
+	scip::call(SCIPlpiSolveDual, lpi.get());
+	if (!SCIPlpiIsOptimal(lpi.get())) {
+		// Infeasible and unbounded LPs have an infinite objective, in the direction of the original objective sense.
+		auto const sense = (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MAXIMIZE) ? -1. : 1.;
+		auto const inf = std::numeric_limits<SCIP_Real>::infinity();
+		if (SCIPlpiIsPrimalInfeasible(lpi.get())) {
+			return {sense * inf, {}};
+		}
+		if (SCIPlpiIsPrimalUnbounded(lpi.get()) || SCIPlpiIsDualInfeasible(lpi.get())) {
+			return {-sense * inf, {}};
+		}
+		return {};
+	}
+
+	auto solution = LpSolution{0., std::vector<SCIP_Real>(n_var), true};
+	scip::call(SCIPlpiGetSol, lpi.get(), &solution.objective, solution.values.data(), nullptr, nullptr, nullptr);
+	if (in_original_space(scip)) {
+		solution.objective += SCIPgetOrigObjoffset(scip);
+	} else {
+		solution.objective = SCIPretransformObj(scip, solution.objective);
+	}
+	return solution;
 }
 
-/** [21-24] LP based features. */
-template <typename Tensor> void set_lp_based_features(Tensor&& out, scip::Model const& model) {
-	auto const [lp_solution, lp_objective] = solve_lp_relaxation(model);
+/**
+ * Incremental FNV-1a hash of the bytes of some values.
+ *
+ * Used to recognize an instance already seen from its data.
+ */
+class Fingerprint {
+public:
+	template <typename T> auto add(T const& val) noexcept -> Fingerprint& {
+		static_assert(std::is_trivially_copyable_v<T>);
+		auto bytes = std::array<unsigned char, sizeof(T)>{};
+		std::memcpy(bytes.data(), &val, sizeof(T));
+		for (auto const byte : bytes) {
+			state = (state ^ static_cast<std::uint64_t>(byte)) * prime;
+		}
+		return *this;
+	}
+
+	template <typename Range> auto add_all(Range const& range) noexcept -> Fingerprint& {
+		for (auto const& val : range) {
+			add(val);
+		}
+		return *this;
+	}
 
-	// Compute the integer slack vector
+	[[nodiscard]] auto value() const noexcept -> std::uint64_t { return state; }
+
+private:
+	static std::uint64_t constexpr prime = 1099511628211ULL;
+	std::uint64_t state = 14695981039346656037ULL;
+};
+
+/** Fingerprint of all the data that the LP based features depend on. */
+auto lp_fingerprint(
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases) -> std::uint64_t {
 	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
-	int const nb_integer_variables = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
-
-	if (nb_integer_variables > 0) {
-		// Compute the integer slack vector
-		auto integer_slack = std::vector<value_type>(static_cast<std::size_t>(nb_integer_variables));
-		std::size_t int_var_idx = 0;
-		for (auto& variable : model.variables()) {
-			if (SCIPvarIsIntegral(variable)) {
-				auto lp_solution_coef = lp_solution[int_var_idx];
-				integer_slack[int_var_idx] = std::abs(lp_solution_coef - std::round(lp_solution_coef));
-				int_var_idx++;
-			}
+	auto fingerprint = Fingerprint{};
+	fingerprint.add(in_original_space(scip)).add(SCIPgetObjsense(scip)).add(SCIPgetOrigObjoffset(scip));
+	for (auto* const var : model.variables()) {
+		fingerprint.add(SCIPvarGetObj(var)).add(SCIPvarGetLbGlobal(var)).add(SCIPvarGetUbGlobal(var));
+		fingerprint.add(SCIPvarIsIntegral(var));
+	}
+	fingerprint.add_all(cons_matrix.shape).add_all(cons_matrix.indices).add_all(cons_matrix.values);
+	fingerprint.add_all(cons_biases);
+	return fingerprint.value();
+}
+
+/**
+ * [21-24] LP based features.
+ *
+ * When the LP relaxation is not solved to optimality, the slack features are NaN, and the objective value is infinite
+ * if the LP is infeasible (positive when minimizing) or unbounded (negative when minimizing), and NaN otherwise.
+ */
+auto compute_lp_based_features(
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases) -> Hutter2011::LpFeatures {
+	auto lp_features = Hutter2011::LpFeatures{};
+	auto const lp_solution = solve_lp_relaxation(model, cons_matrix, cons_biases);
+	if (!lp_solution.optimal) {
+		auto constexpr nan = std::numeric_limits<value_type>::quiet_NaN();
+		return {nan, nan, nan, lp_solution.objective};
+	}
+
+	// Compute the integer slack vector
+	auto const variables = model.variables();
+	auto integer_slack = std::vector<value_type>{};
+	for (std::size_t var_idx = 0; var_idx < variables.size(); ++var_idx) {
+		if (SCIPvarIsIntegral(variables[var_idx])) {
+			auto const lp_solution_coef = lp_solution.values[var_idx];
+			integer_slack.push_back(std::abs(lp_solution_coef - std::round(lp_solution_coef)));
 		}
+	}
 
+	if (!integer_slack.empty()) {
 		// Compute statistics of the integer slack vector
 		auto const slack_stats = utility::compute_stats(integer_slack);
 		auto const square = [](auto val) { return val * val; };
 		auto const slack_l2_norm = ranges::accumulate(integer_slack | views::transform(square), 0.);
+		lp_features[0] = slack_stats.mean;
+		lp_features[1] = slack_stats.max;
+		lp_features[2] = slack_l2_norm;
+	}
+	lp_features[3] = lp_solution.objective;
+	return lp_features;
+}
 
-		out[idx(Features::lp_slack_mean)] = slack_stats.mean;
-		out[idx(Features::lp_slack_max)] = slack_stats.max;
-		out[idx(Features::lp_slack_l2)] = slack_l2_norm;
-	} else {
-		out[idx(Features::lp_slack_mean)] = 0;
-		out[idx(Features::lp_slack_max)] = 0;
-		out[idx(Features::lp_slack_l2)] = 0;
+/**
+ * [21-24] LP based features, memoized by the fingerprint of the LP relaxation.
+ *
+ * An arbitrary entry of the memo is dropped when it is full.
+ */
+template <typename Tensor>
+void set_lp_based_features(
+	Tensor&& out,
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases,
+	Hutter2011::LpFeaturesMemo& memo,
+	std::size_t& n_lp_solved) {
+	auto const fingerprint = lp_fingerprint(model, cons_matrix, cons_biases);
+	auto memo_iter = memo.find(fingerprint);
+	if (memo_iter == memo.end()) {
+		auto lp_features = compute_lp_based_features(model, cons_matrix, cons_biases);
+		++n_lp_solved;
+		if (memo.size() >= Hutter2011::lp_memo_capacity) {
+			memo.erase(memo.begin());
+		}
+		memo_iter = memo.emplace(fingerprint, lp_features).first;
 	}
-	out[idx(Features::lp_objective_value)] = lp_objective;
+	auto const& lp_features = memo_iter->second;
+	out[idx(Features::lp_slack_mean)] = lp_features[0];
+	out[idx(Features::lp_slack_max)] = lp_features[1];
+	out[idx(Features::lp_slack_l2)] = lp_features[2];
+	out[idx(Features::lp_objective_value)] = lp_features[3];
 }
 
 /** [25-27] Objective function features. */
@@ -362,19 +715,36 @@ template <typename Tensor> void set_variable_type_features(Tensor&& out, scip::M
 	out[idx(Features::ratio_continuous_vars)] = nb_cont_vars / (nb_int_vars + nb_cont_vars);
 }
 
-auto extract_features(scip::Model& model) {
+auto extract_features(
+	scip::Model& model,
+	std::optional<std::size_t> graph_budget,
+	std::optional<std::size_t> triangle_budget,
+	std::size_t n_samples,
+	Hutter2011::LpFeaturesMemo& lp_memo,
+	std::size_t& n_lp_solved) {
 	auto observation = xt::xtensor<value_type, 1>::from_shape({Hutter2011Obs::n_features});
+	xt::xtensor<value_type, 1> errors = xt::zeros<value_type>({Hutter2011Obs::n_features});
 	auto const [cons_matrix, cons_biases] = scip::get_all_constraints(model.get_scip_ptr());
+	auto const var_incidence = get_var_incidence(cons_matrix);
+	auto const n_var = var_incidence.n_nodes();
+	// Seeded with the model's seed so that the estimates are reproducible.
+	auto rng = RandomGenerator{static_cast<Seed>(model.get_param<int>("randomization/randomseedshift"))};
+	auto const var_graph = [&] {
+		if (!graph_budget.has_value() || (var_incidence.expansion_work() <= graph_budget.value())) {
+			return sample_var_graph(utility::CsrGraph::clique_expansion(var_incidence), triangle_budget, rng);
+		}
+		return sample_var_graph(var_incidence, sample_variables(n_var, n_samples, rng), rng);
+	}();
 
 	set_problem_size(observation, cons_matrix);
 	set_var_cons_degrees(observation, cons_matrix);
-	set_var_degrees(observation, cons_matrix);
-	set_lp_based_features(observation, model);
+	set_var_graph_features(observation, errors, var_graph, n_var);
+	set_lp_based_features(observation, model, cons_matrix, cons_biases, lp_memo, n_lp_solved);
 	set_obj_features(observation, model, cons_matrix);
 	set_cons_matrix_features(observation, cons_matrix, cons_biases);
 	set_variable_type_features(observation, model);
 
-	return observation;
+	return Hutter2011Obs{std::move(observation), std::move(errors)};
 }
 
 }  // namespace
@@ -383,11 +753,17 @@ auto extract_features(scip::Model& model) {
  *  Observation extracting function  *
  *************************************/
 
+Hutter2011::Hutter2011(
+	std::optional<std::size_t> graph_budget_,
+	std::size_t n_samples_,
+	std::optional<std::size_t> triangle_budget_) noexcept :
+	graph_budget{graph_budget_}, triangle_budget{triangle_budget_}, n_samples{n_samples_} {}
+
 auto Hutter2011::extract(scip::Model& model, bool /* done */) -> std::optional<Hutter2011Obs> {
 	if (model.stage() >= SCIP_STAGE_SOLVING) {
 		return {};
 	}
-	return {{extract_features(model)}};
+	return extract_features(model, graph_budget, triangle_budget, n_samples, lp_memo, lp_solve_count);
 }
 
 }  // namespace ecole::observation
@@ -1,17 +1,18 @@
+#include <array>
 #include <cmath>
-#include <set>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
-#include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 #include <xtensor/xfixed.hpp>
 #include <xtensor/xview.hpp>
 
+#include "ecole/data/step-context.hpp"
 #include "ecole/observation/khalil-2016.hpp"
 #include "ecole/scip/col.hpp"
 #include "ecole/scip/model.hpp"
@@ -361,53 +362,69 @@ auto row_is_active(SCIP* const scip, SCIP_ROW* const row) noexcept -> bool {
 }
 
 /**
- * Compute the weight necessary for the stats for active constraints coefficients.
+ * Weights of the active LP rows for the stats for active constraints coefficients.
  *
- * The four coefficients are
+ * The four weights of a row are
  *   - unit weight,
  *   - inverse of the sum of the coefficients of all variables in constraint,
  *   - inverse of the sum of the coefficients of only candidate variables in constraint
  *   - dual cost of the constraint.
- * They are computed for every row that is active, as defined by @ref row_is_active.
+ * They are computed for every row that is active, as defined by @ref row_is_active, and indexed by LP position.
  * Weights for non activate rows are left as NaN and ununsed.
- * This is equivalent to an unsafe/unchecked masked tensor.
  */
-auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
-	auto* const scip = model.get_scip_ptr();
-	auto const lp_rows = model.lp_rows();
-	auto const branch_candidates = model.pseudo_branch_cands() | ranges::to<std::set>();
+struct ActiveRowsWeights {
+	xt::xtensor<value_type, 2> weights;
+	std::vector<bool> is_active;
+};
 
-	/** Check if a column is a branching candidate. */
-	auto is_candidate = [&branch_candidates](auto* col) { return branch_candidates.count(SCIPcolGetVar(col)) > 0; };
-
-	/** Compute the sum of absolute values in a range. */
-	auto sum_abs = [](auto range) {
-		return ranges::accumulate(range | views::transform([](auto x) { return std::abs(x); }), 0.);
-	};
+/**
+ * Mark the pseudo branching candidates in a dense bitmap indexed by problem index.
+ *
+ * Rows can contain columns that are not in the LP, so the problem index is used rather than the LP position.
+ */
+auto pseudo_candidates_bitmap(scip::Model& model, data::StepContext& context) {
+	auto is_candidate = std::vector<bool>(model.variables().size(), false);
+	for (auto const var_idx : context.pseudo_branch_cands(model).indices) {
+		is_candidate[var_idx] = true;
+	}
+	return is_candidate;
+}
 
-	/** Compute the sum of absolute value of column coefficient if the column is a branching candidate. */
-	auto sum_abs_if_candidate = [&is_candidate](auto const& row_cols, auto const& row_cols_vals) {
-		auto sum = value_type{0.};
-		for (auto const [col, val] : views::zip(row_cols, row_cols_vals)) {
-			if (is_candidate(col)) {
-				sum += std::abs(val);
-			}
-		}
-		return sum;
-	};
+auto stats_for_active_constraint_coefficients_weights(scip::Model& model, data::StepContext& context)
+	-> ActiveRowsWeights {
+	auto* const scip = model.get_scip_ptr();
+	auto const lp_rows = model.lp_rows();
+	auto const is_candidate = pseudo_candidates_bitmap(model, context);
 
 	/** Compute the inverse of a number or 1 if the number is zero. */
 	auto safe_inv = [](auto const x) { return x != 0. ? 1. / x : 1.; };
 
-	xt::xtensor<value_type, 2> weights{{lp_rows.size(), 4}, std::nan("")};
-	auto* weights_iter = weights.begin();
+	auto out = ActiveRowsWeights{
+		xt::xtensor<value_type, 2>{{lp_rows.size(), 4}, std::nan("")},
+		std::vector<bool>(lp_rows.size(), false),
+	};
+	auto* weights_iter = out.weights.begin();
 
-	for (auto* const row : lp_rows) {
+	for (std::size_t row_idx = 0; row_idx < lp_rows.size(); ++row_idx) {
+		auto* const row = lp_rows[row_idx];
 		if (row_is_active(scip, row)) {
+			out.is_active[row_idx] = true;
+			// Sum of absolute coefficients, of all columns and of candidate columns only, in a single pass.
+			auto const row_cols = scip::get_cols(row);
 			auto const row_cols_vals = scip::get_vals(row);
+			auto sum_abs = value_type{0.};
+			auto sum_abs_candidates = value_type{0.};
+			for (std::size_t col_idx = 0; col_idx < row_cols.size(); ++col_idx) {
+				auto const abs_val = std::abs(row_cols_vals[col_idx]);
+				sum_abs += abs_val;
+				auto const var_idx = SCIPvarGetProbindex(SCIPcolGetVar(row_cols[col_idx]));
+				if ((var_idx >= 0) && is_candidate[static_cast<std::size_t>(var_idx)]) {
+					sum_abs_candidates += abs_val;
+				}
+			}
 			*(weights_iter++) = 1.;
-			*(weights_iter++) = safe_inv(sum_abs(row_cols_vals));
-			*(weights_iter++) = safe_inv(sum_abs_if_candidate(scip::get_cols(row), row_cols_vals));
+			*(weights_iter++) = safe_inv(sum_abs);
+			*(weights_iter++) = safe_inv(sum_abs_candidates);
 			*(weights_iter++) = std::abs(SCIProwGetDualsol(row));
 		} else {
 			weights_iter += 4;
@@ -415,9 +432,9 @@ auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
 	}
 
 	// Make sure we iterated over as many element as there are in the tensor
-	assert(weights_iter == weights.cend());
+	assert(weights_iter == out.weights.cend());
 
-	return weights;
+	return out;
 }
 
 /**
@@ -430,67 +447,54 @@ auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
  * Given the absolute value of the coefficients of xj in the active constraints, we compute the
  * sum, mean, stdev., max. and min. of those values, for each of the weighting schemes. We also
  * compute the weighted number of active constraints that xj is in, with the same 4 weightings.
+ *
+ * All statistics are computed in a single pass over the rows, with Welford's algorithm for the standard deviation.
  */
 template <typename Tensor>
 void set_stats_for_active_constraint_coefficients(
 	Tensor&& out,
-	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
 	nonstd::span<SCIP_Real> const coefficients,
-	xt::xtensor<value_type, 2> const& lp_rows_weights) noexcept {
+	ActiveRowsWeights const& lp_rows_weights) noexcept {
 
 	auto weights_stats = std::array<utility::StatsFeatures<value_type>, 4>{};
 	for (auto& stats : weights_stats) {
 		stats.min = std::numeric_limits<decltype(stats.min)>::max();
 		stats.max = std::numeric_limits<decltype(stats.max)>::min();
 	}
+	// Sum of squared deviations from the running mean
+	auto weights_m2 = std::array<value_type, 4>{};
 
 	std::size_t n_active_rows = 0UL;
 	for (auto const [row, coef] : views::zip(rows, coefficients)) {
 		auto const row_lp_idx = SCIProwGetLPPos(row);
-
-		if (row_is_active(scip, row)) {
-			n_active_rows++;
-
-			assert(row_lp_idx >= 0);
-
-			for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
-				auto const weight = lp_rows_weights(row_lp_idx, weight_idx);
-				assert(!std::isnan(weight));  // If NaN likely hit a maked value
-				auto const weighted_abs_coef = weight * std::abs(coef);
-
-				auto& stats = weights_stats[weight_idx];
-				stats.count += weight;
-				stats.sum += weighted_abs_coef;
-				stats.min = std::min(stats.min, weighted_abs_coef);
-				stats.max = std::max(stats.max, weighted_abs_coef);
-			}
+		if ((row_lp_idx < 0) || !lp_rows_weights.is_active[static_cast<std::size_t>(row_lp_idx)]) {
+			continue;
+		}
+		n_active_rows++;
+
+		auto const abs_coef = std::abs(coef);
+		for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
+			auto const weight = lp_rows_weights.weights(static_cast<std::size_t>(row_lp_idx), weight_idx);
+			assert(!std::isnan(weight));  // If NaN likely hit a maked value
+			auto const weighted_abs_coef = weight * abs_coef;
+
+			auto& stats = weights_stats[weight_idx];
+			stats.count += weight;
+			stats.sum += weighted_abs_coef;
+			stats.min = std::min(stats.min, weighted_abs_coef);
+			stats.max = std::max(stats.max, weighted_abs_coef);
+			auto const delta = weighted_abs_coef - stats.mean;
+			stats.mean += delta / static_cast<value_type>(n_active_rows);
+			weights_m2[weight_idx] += delta * (weighted_abs_coef - stats.mean);
 		}
 	}
 
 	if (n_active_rows > 0) {
-		for (auto& stats : weights_stats) {
-			stats.mean = stats.sum / static_cast<value_type>(n_active_rows);
+		for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
+			auto const variance = weights_m2[weight_idx] / static_cast<value_type>(n_active_rows);
+			weights_stats[weight_idx].stddev = std::sqrt(variance);
 		}
-
-		for (auto const [row, coef] : views::zip(rows, coefficients)) {
-			auto const row_lp_idx = SCIProwGetLPPos(row);
-			if (row_is_active(scip, row)) {
-				for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
-					auto const weight = lp_rows_weights(row_lp_idx, weight_idx);
-					assert(!std::isnan(weight));  // If NaN likely hit a maked value
-					auto const weighted_abs_coef = weight * std::abs(coef);
-
-					auto& stats = weights_stats[weight_idx];
-					stats.stddev = square(weighted_abs_coef - stats.mean);
-				}
-			}
-		}
-
-		for (auto& stats : weights_stats) {
-			stats.stddev = std::sqrt(stats.stddev / static_cast<value_type>(n_active_rows));
-		}
-
 	} else {
 		for (auto& stats : weights_stats) {
 			stats = {};
@@ -534,7 +538,7 @@ void set_dynamic_features(
 	Tensor&& out,
 	SCIP* const scip,
 	SCIP_VAR* const var,
-	xt::xtensor<value_type, 2> const& lp_rows_weights) {
+	ActiveRowsWeights const& lp_rows_weights) {
 	auto* const col = SCIPvarGetCol(var);
 	auto const rows = scip::get_rows(col);
 	auto const coefficients = scip::get_vals(col);
@@ -544,7 +548,7 @@ void set_dynamic_features(
 	set_dynamic_stats_for_constraint_degree(out, rows);
 	set_min_max_for_ratios_constraint_coeffs_rhs(out, scip, rows, coefficients);
 	set_min_max_for_one_to_all_coefficient_ratios(out, rows, coefficients);
-	set_stats_for_active_constraint_coefficients(out, scip, rows, coefficients, lp_rows_weights);
+	set_stats_for_active_constraint_coefficients(out, rows, coefficients, lp_rows_weights);
 }
 
 /**
@@ -563,22 +567,35 @@ void set_precomputed_static_features(TensorOut&& var_features, TensorIn const& v
  *  Main extraction function  *
  ******************************/
 
-auto extract_all_features(scip::Model& model, bool pseudo, xt::xtensor<value_type, 2> const& static_features) {
-	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
-	auto observation = xt::xtensor<value_type, 2>{{model.variables().size(), Khalil2016Obs::n_features}, std::nan("")};
+void extract_all_features(
+	scip::Model& model,
+	bool pseudo,
+	bool candidates_only,
+	xt::xtensor<value_type, 2> const& static_features,
+	Khalil2016Obs& observation,
+	data::StepContext& context) {
+	auto const& branch_cands = pseudo ? context.pseudo_branch_cands(model) : context.lp_branch_cands(model);
+	auto const n_cands = branch_cands.variables.size();
+	if (candidates_only) {
+		// Every row is a candidate, and is entirely written.
+		observation.features.resize({n_cands, Khalil2016Obs::n_features});
+	} else {
+		observation.features.resize({model.variables().size(), Khalil2016Obs::n_features});
+		observation.features.fill(std::nan(""));
+	}
+	observation.candidates = branch_cands.indices;
 
 	auto* const scip = model.get_scip_ptr();
-	auto const lp_rows_weights = stats_for_active_constraint_coefficients_weights(model);
+	auto const lp_rows_weights = stats_for_active_constraint_coefficients_weights(model, context);
 
-	for (auto* var : branch_cands) {
-		auto const var_idx = SCIPvarGetProbindex(var);
-		auto var_features = xt::row(observation, var_idx);
+	for (std::size_t cand_idx = 0; cand_idx < n_cands; ++cand_idx) {
+		auto* const var = branch_cands.variables[cand_idx];
+		auto const var_idx = branch_cands.indices[cand_idx];
+		auto var_features = xt::row(observation.features, candidates_only ? cand_idx : var_idx);
 		auto var_static_features = xt::row(static_features, var_idx);
 		set_precomputed_static_features(var_features, var_static_features);
 		set_dynamic_features(var_features, scip, var, lp_rows_weights);
 	}
-
-	return observation;
 }
 
 auto is_on_root_node(scip::Model& model) -> bool {
@@ -592,20 +609,68 @@ auto is_on_root_node(scip::Model& model) -> bool {
  *  Observation extracting function  *
  *************************************/
 
-Khalil2016::Khalil2016(bool pseudo_candidates_) noexcept : pseudo_candidates(pseudo_candidates_) {}
+Khalil2016::Khalil2016(bool pseudo_candidates_, bool candidates_only_) noexcept :
+	pseudo_candidates(pseudo_candidates_), candidates_only(candidates_only_) {}
 
 void Khalil2016::before_reset(scip::Model& /* model */) {
 	static_features = decltype(static_features){};
 }
 
-auto Khalil2016::extract(scip::Model& model, bool /* done */) -> std::optional<Khalil2016Obs> {
-	if (model.stage() == SCIP_STAGE_SOLVING) {
-		if (is_on_root_node(model)) {
-			static_features = extract_static_features(model);
-		}
-		return {{extract_all_features(model, pseudo_candidates, static_features)}};
+auto Khalil2016::extract(scip::Model& model, bool done) -> std::optional<Khalil2016Obs> {
+	auto context = data::StepContext{};
+	return extract_in_context(model, done, context);
+}
+
+auto Khalil2016::extract_in_context(scip::Model& model, bool done, data::StepContext& context)
+	-> std::optional<Khalil2016Obs> {
+	auto obs = std::optional<Khalil2016Obs>{};
+	extract_into(model, done, obs, context);
+	return obs;
+}
+
+auto Khalil2016::extract_into(scip::Model& model, bool done, std::optional<Khalil2016Obs>& obs) -> void {
+	auto context = data::StepContext{};
+	extract_into(model, done, obs, context);
+}
+
+auto Khalil2016::extract_into(
+	scip::Model& model,
+	bool done,
+	std::optional<Khalil2016Obs>& obs,
+	data::StepContext& context) -> void {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		obs.reset();
+		return;
+	}
+	if (!obs.has_value()) {
+		obs.emplace();
+	}
+	extract_into(model, done, obs.value(), context);
+}
+
+auto Khalil2016::extract_into(scip::Model& model, bool /* done */, Khalil2016Obs& obs, data::StepContext& context)
+	-> bool {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return false;
+	}
+	if (is_on_root_node(model)) {
+		static_features = extract_static_features(model);
+	}
+	extract_all_features(model, pseudo_candidates, candidates_only, static_features, obs, context);
+	return true;
+}
+
+auto Khalil2016::keeps_shapes_of(scip::Model& model, Khalil2016Obs const& obs, data::StepContext& context) const
+	-> bool {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return false;
 	}
-	return {};
+	auto const& branch_cands = pseudo_candidates ? context.pseudo_branch_cands(model) : context.lp_branch_cands(model);
+	auto const n_cands = branch_cands.variables.size();
+	auto const n_rows = candidates_only ? n_cands : model.variables().size();
+	using Shape = std::array<std::size_t, 2>;
+	return (obs.features.shape() == Shape{n_rows, Khalil2016Obs::n_features}) &&
+	       (obs.candidates.shape() == std::array<std::size_t, 1>{n_cands});
 }
 
 }  // namespace ecole::observation
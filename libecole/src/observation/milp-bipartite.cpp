@@ -2,10 +2,12 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
 #include <xtensor/xadapt.hpp>
 #include <xtensor/xnorm.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/exception.hpp"
@@ -22,12 +24,12 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(MilpBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
-using coo_xmatrix = utility::coo_matrix<value_type>;
+template <typename Value> using xmatrix = xt::xtensor<Value, 2>;
+// Intermediary computations are done in double precision regardless of the precision of the observation
+using value_type = SCIP_Real;
 
-using VariableFeatures = MilpBipartiteObs::VariableFeatures;
-using ConstraintFeatures = MilpBipartiteObs::ConstraintFeatures;
+using VariableFeatures = MilpBipartiteFeatures::VariableFeatures;
+using ConstraintFeatures = MilpBipartiteFeatures::ConstraintFeatures;
 
 /******************************************
  *  Variable extraction functions         *
@@ -56,6 +58,11 @@ template <typename E> constexpr auto idx(E e) {
 	return static_cast<std::underlying_type_t<E>>(e);
 }
 
+/** Write a feature, converting it to the precision of the observation. */
+template <typename Features, typename E> void set_feature(Features&& out, E feature, value_type val) {
+	out[idx(feature)] = static_cast<typename std::decay_t<Features>::value_type>(val);
+}
+
 template <typename Features>
 void set_static_features_for_var(
 	Features&& out,
@@ -64,27 +71,25 @@ void set_static_features_for_var(
 	std::optional<value_type> obj_norm = {}) {
 	double const objsense = (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MINIMIZE) ? 1. : -1.;
 
-	out[idx(VariableFeatures::objective)] = objsense * SCIPvarGetObj(var);
-	if (obj_norm.has_value()) {
-		out[idx(VariableFeatures::objective)] /= obj_norm.value();
-	}
+	auto const objective = objsense * SCIPvarGetObj(var);
+	set_feature(out, VariableFeatures::objective, obj_norm.has_value() ? objective / obj_norm.value() : objective);
 	// One-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
+	set_feature(out, VariableFeatures::is_type_binary, 0.);
+	set_feature(out, VariableFeatures::is_type_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_continuous, 0.);
 	switch (SCIPvarGetType(var)) {
 	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
+		set_feature(out, VariableFeatures::is_type_binary, 1.);
 		break;
 	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_integer, 1.);
 		break;
 	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
 		break;
 	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
+		set_feature(out, VariableFeatures::is_type_continuous, 1.);
 		break;
 	default:
 		utility::unreachable();
@@ -92,24 +97,24 @@ void set_static_features_for_var(
 
 	auto const lower_bound = SCIPvarGetLbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(lower_bound))) {
-		out[idx(VariableFeatures::has_lower_bound)] = 0.;
-		out[idx(VariableFeatures::lower_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_lower_bound, 0.);
+		set_feature(out, VariableFeatures::lower_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_lower_bound)] = 1.;
-		out[idx(VariableFeatures::lower_bound)] = lower_bound;
+		set_feature(out, VariableFeatures::has_lower_bound, 1.);
+		set_feature(out, VariableFeatures::lower_bound, lower_bound);
 	}
 
 	auto const upper_bound = SCIPvarGetUbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(upper_bound))) {
-		out[idx(VariableFeatures::has_upper_bound)] = 0.;
-		out[idx(VariableFeatures::upper_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_upper_bound, 0.);
+		set_feature(out, VariableFeatures::upper_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_upper_bound)] = 1.;
-		out[idx(VariableFeatures::upper_bound)] = upper_bound;
+		set_feature(out, VariableFeatures::has_upper_bound, 1.);
+		set_feature(out, VariableFeatures::upper_bound, upper_bound);
 	}
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool normalize) {
+template <typename Value> void set_features_for_all_vars(xmatrix<Value>& out, scip::Model& model, bool normalize) {
 	auto* const scip = model.get_scip_ptr();
 
 	// Contant reused in every iterations
@@ -128,26 +133,51 @@ template <typename T> auto vec_to_col(xt::xtensor<T, 1>&& t) -> xt::xtensor<T, 2
 	return xt::xtensor<T, 2>{std::move(t.storage()), {t.size(), 1}, {1, 0}};
 }
 
+/** Convert a xtensor to another element type, without copy if it is the same. */
+template <typename To, typename From, std::size_t N> auto convert(xt::xtensor<From, N>&& t) -> xt::xtensor<To, N> {
+	if constexpr (std::is_same_v<To, From>) {
+		return std::move(t);
+	} else {
+		return xt::xtensor<To, N>{xt::cast<To>(t)};
+	}
+}
+
+template <typename Value, typename Index>
+auto convert_matrix(utility::coo_matrix<SCIP_Real>&& matrix) -> utility::coo_matrix<Value, Index> {
+	return {convert<Value>(std::move(matrix.values)), convert<Index>(std::move(matrix.indices)), matrix.shape};
+}
+
 }  // namespace
 
 /*************************************
  *  Observation extracting function  *
  *************************************/
 
-auto MilpBipartite::extract(scip::Model& model, bool /* done */) const -> std::optional<MilpBipartiteObs> {
+template <typename Value, typename Index>
+auto BasicMilpBipartite<Value, Index>::extract(scip::Model& model, bool /* done */) const
+	-> std::optional<Observation> {
 	if (model.stage() < SCIP_STAGE_SOLVING) {
 		auto [edge_features, constraint_features] = scip::get_all_constraints(model.get_scip_ptr(), normalize);
 
-		auto variable_features = xmatrix::from_shape({model.variables().size(), MilpBipartiteObs::n_variable_features});
-		set_features_for_all_vars(variable_features, model, normalize);
-
-		return MilpBipartiteObs{
-			std::move(variable_features),
-			vec_to_col(std::move(constraint_features)),
-			std::move(edge_features),
-		};
+		auto obs = Observation{};
+		auto const n_vars = model.variables().size();
+		obs.variable_features = xmatrix<Value>::from_shape({n_vars, Observation::n_variable_features});
+		set_features_for_all_vars(obs.variable_features, model, normalize);
+		// Constraints are read in double precision and converted once, as this is only done before solving
+		obs.constraint_features = vec_to_col(convert<Value>(std::move(constraint_features)));
+		if (csr) {
+			// Converted while compressed, rather than through a converted copy of the coordinate matrix
+			utility::coo_to_csr(edge_features, obs.edge_features_csr);
+		} else {
+			obs.edge_features = convert_matrix<Value, Index>(std::move(edge_features));
+		}
+		return obs;
 	}
 	return {};
 }
 
+template class BasicMilpBipartite<double, std::size_t>;
+template class BasicMilpBipartite<float, std::int32_t>;
+template class BasicMilpBipartite<float, std::int64_t>;
+
 }  // namespace ecole::observation
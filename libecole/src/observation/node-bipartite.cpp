@@ -1,13 +1,24 @@
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <objscip/objeventhdlr.h>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
 #include <xtensor/xview.hpp>
 
+#include "ecole/data/concurrent.hpp"
+#include "ecole/data/step-context.hpp"
 #include "ecole/observation/node-bipartite.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/row.hpp"
@@ -21,17 +32,20 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(NodeBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
+template <typename Value> using xmatrix = xt::xtensor<Value, 2>;
+template <typename Value, typename Index> using coo_matrix = utility::coo_matrix<Value, Index>;
+template <typename Value, typename Index> using csr_matrix = utility::csr_matrix<Value, Index>;
+// Intermediary computations are done in double precision regardless of the precision of the observation
+using value_type = SCIP_Real;
 
-using VariableFeatures = NodeBipartiteObs::VariableFeatures;
-using RowFeatures = NodeBipartiteObs::RowFeatures;
+using VariableFeatures = NodeBipartiteFeatures::VariableFeatures;
+using RowFeatures = NodeBipartiteFeatures::RowFeatures;
 
 value_type constexpr cste = 5.;
 value_type constexpr nan = std::numeric_limits<value_type>::quiet_NaN();
 
-SCIP_Real obj_l2_norm(SCIP* const scip) noexcept {
-	auto const norm = SCIPgetObjNorm(scip);
+SCIP_Real obj_l2_norm(scip::Model& model, data::StepContext& context) {
+	auto const norm = context.obj_norm(model);
 	return norm > 0 ? norm : 1.;
 }
 
@@ -98,26 +112,31 @@ template <typename E> constexpr auto idx(E e) {
 	return static_cast<std::underlying_type_t<E>>(e);
 }
 
+/** Write a feature, converting it to the precision of the observation. */
+template <typename Features, typename E> void set_feature(Features&& out, E feature, value_type val) {
+	out[idx(feature)] = static_cast<typename std::decay_t<Features>::value_type>(val);
+}
+
 template <typename Features>
 void set_static_features_for_var(Features&& out, SCIP_VAR* const var, value_type obj_norm) {
-	out[idx(VariableFeatures::objective)] = SCIPvarGetObj(var) / obj_norm;
+	set_feature(out, VariableFeatures::objective, SCIPvarGetObj(var) / obj_norm);
 	// On-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
+	set_feature(out, VariableFeatures::is_type_binary, 0.);
+	set_feature(out, VariableFeatures::is_type_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_continuous, 0.);
 	switch (SCIPvarGetType(var)) {
 	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
+		set_feature(out, VariableFeatures::is_type_binary, 1.);
 		break;
 	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_integer, 1.);
 		break;
 	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
 		break;
 	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
+		set_feature(out, VariableFeatures::is_type_continuous, 1.);
 		break;
 	default:
 		utility::unreachable();
@@ -132,49 +151,53 @@ void set_dynamic_features_for_var(
 	SCIP_COL* const col,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(VariableFeatures::has_lower_bound)] = static_cast<value_type>(lower_bound(scip, col).has_value());
-	out[idx(VariableFeatures::has_upper_bound)] = static_cast<value_type>(upper_bound(scip, col).has_value());
-	out[idx(VariableFeatures::normed_reduced_cost)] = SCIPgetVarRedcost(scip, var) / obj_norm;
-	out[idx(VariableFeatures::solution_value)] = SCIPvarGetLPSol(var);
-	out[idx(VariableFeatures::solution_frac)] = feas_frac(scip, var).value_or(0.);
-	out[idx(VariableFeatures::is_solution_at_lower_bound)] = static_cast<value_type>(is_prim_sol_at_lb(scip, col));
-	out[idx(VariableFeatures::is_solution_at_upper_bound)] = static_cast<value_type>(is_prim_sol_at_ub(scip, col));
-	out[idx(VariableFeatures::scaled_age)] = static_cast<value_type>(SCIPcolGetAge(col)) / (n_lps + cste);
-	out[idx(VariableFeatures::incumbent_value)] = best_sol_val(scip, var).value_or(nan);
-	out[idx(VariableFeatures::average_incumbent_value)] = avg_sol(scip, var).value_or(nan);
+	set_feature(out, VariableFeatures::has_lower_bound, static_cast<value_type>(lower_bound(scip, col).has_value()));
+	set_feature(out, VariableFeatures::has_upper_bound, static_cast<value_type>(upper_bound(scip, col).has_value()));
+	set_feature(out, VariableFeatures::normed_reduced_cost, SCIPgetVarRedcost(scip, var) / obj_norm);
+	set_feature(out, VariableFeatures::solution_value, SCIPvarGetLPSol(var));
+	set_feature(out, VariableFeatures::solution_frac, feas_frac(scip, var).value_or(0.));
+	set_feature(
+		out, VariableFeatures::is_solution_at_lower_bound, static_cast<value_type>(is_prim_sol_at_lb(scip, col)));
+	set_feature(
+		out, VariableFeatures::is_solution_at_upper_bound, static_cast<value_type>(is_prim_sol_at_ub(scip, col)));
+	set_feature(out, VariableFeatures::scaled_age, static_cast<value_type>(SCIPcolGetAge(col)) / (n_lps + cste));
+	set_feature(out, VariableFeatures::incumbent_value, best_sol_val(scip, var).value_or(nan));
+	set_feature(out, VariableFeatures::average_incumbent_value, avg_sol(scip, var).value_or(nan));
 	// On-hot encoding
-	out[idx(VariableFeatures::is_basis_lower)] = 0.;
-	out[idx(VariableFeatures::is_basis_basic)] = 0.;
-	out[idx(VariableFeatures::is_basis_upper)] = 0.;
-	out[idx(VariableFeatures::is_basis_zero)] = 0.;
+	set_feature(out, VariableFeatures::is_basis_lower, 0.);
+	set_feature(out, VariableFeatures::is_basis_basic, 0.);
+	set_feature(out, VariableFeatures::is_basis_upper, 0.);
+	set_feature(out, VariableFeatures::is_basis_zero, 0.);
 	switch (SCIPcolGetBasisStatus(col)) {
 	case SCIP_BASESTAT_LOWER:
-		out[idx(VariableFeatures::is_basis_lower)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_lower, 1.);
 		break;
 	case SCIP_BASESTAT_BASIC:
-		out[idx(VariableFeatures::is_basis_basic)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_basic, 1.);
 		break;
 	case SCIP_BASESTAT_UPPER:
-		out[idx(VariableFeatures::is_basis_upper)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_upper, 1.);
 		break;
 	case SCIP_BASESTAT_ZERO:
-		out[idx(VariableFeatures::is_basis_zero)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_zero, 1.);
 		break;
 	default:
 		utility::unreachable();
 	}
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool const update_static) {
-	auto* const scip = model.get_scip_ptr();
-
-	// Contant reused in every iterations
-	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
-	auto const obj_norm = obj_l2_norm(scip);
-
-	auto const variables = model.variables();
-	auto const n_vars = variables.size();
-	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+/** Write the features of the variables in [var_begin, var_end). */
+template <typename Value>
+void set_features_for_vars(
+	xmatrix<Value>& out,
+	SCIP* const scip,
+	nonstd::span<SCIP_VAR*> const variables,
+	std::size_t var_begin,
+	std::size_t var_end,
+	bool const update_static,
+	value_type obj_norm,
+	value_type n_lps) {
+	for (std::size_t var_idx = var_begin; var_idx < var_end; ++var_idx) {
 		auto* const var = variables[var_idx];
 		auto* const col = SCIPvarGetCol(var);
 		auto features = xt::row(out, static_cast<std::ptrdiff_t>(var_idx));
@@ -185,48 +208,65 @@ void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool const upda
 	}
 }
 
+template <typename Value>
+void set_features_for_all_vars(
+	xmatrix<Value>& out,
+	scip::Model& model,
+	bool const update_static,
+	data::StepContext& context) {
+	auto* const scip = model.get_scip_ptr();
+
+	// Contant reused in every iterations
+	auto const n_lps = static_cast<value_type>(context.n_lps(model));
+	auto const obj_norm = obj_l2_norm(model, context);
+
+	auto const variables = model.variables();
+	set_features_for_vars(out, scip, variables, 0, variables.size(), update_static, obj_norm, n_lps);
+}
+
 /***************************************
  *  Row features extraction functions  *
  ***************************************/
 
-SCIP_Real row_l2_norm(SCIP_ROW* const row) noexcept {
-	auto const norm = SCIProwGetNorm(row);
+SCIP_Real row_l2_norm(SCIP_Real const norm) noexcept {
 	return norm > 0 ? norm : 1.;
 }
 
-SCIP_Real obj_cos_sim(SCIP* const scip, SCIP_ROW* const row) noexcept {
-	auto const norm_prod = SCIProwGetNorm(row) * SCIPgetObjNorm(scip);
-	if (SCIPisPositive(scip, norm_prod)) {
-		return row->objprod / norm_prod;
-	}
-	return 0.;
-}
-
 /**
- * Number of inequality rows.
+ * Cosine similarity between a row and the objective.
  *
- * Row are counted once per right hand side and once per left hand side.
+ * The norms are taken from the context, since SCIPgetObjNorm may recompute the norm in place, which is not safe
+ * from concurrent threads.
+ * A null norm is replaced by one, which does not change the result since the row objective product is then zero.
  */
-std::size_t n_ineq_rows(scip::Model& model) {
-	auto* const scip = model.get_scip_ptr();
-	std::size_t count = 0;
-	for (auto* row : model.lp_rows()) {
-		count += static_cast<std::size_t>(scip::get_unshifted_lhs(scip, row).has_value());
-		count += static_cast<std::size_t>(scip::get_unshifted_rhs(scip, row).has_value());
+SCIP_Real obj_cos_sim(SCIP* const scip, SCIP_ROW* const row, value_type row_norm, value_type obj_norm) noexcept {
+	auto const norm_prod = row_norm * obj_norm;
+	if (SCIPisPositive(scip, norm_prod)) {
+		return row->objprod / norm_prod;
 	}
-	return count;
+	return 0.;
 }
 
 template <typename Features>
-void set_static_features_for_lhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = -1 * obj_cos_sim(scip, row);
+void set_static_features_for_lhs_row(
+	Features&& out,
+	SCIP* const scip,
+	SCIP_ROW* const row,
+	value_type row_norm,
+	value_type obj_norm) {
+	set_feature(out, RowFeatures::bias, -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, -1 * obj_cos_sim(scip, row, row_norm, obj_norm));
 }
 
 template <typename Features>
-void set_static_features_for_rhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = scip::get_unshifted_rhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = obj_cos_sim(scip, row);
+void set_static_features_for_rhs_row(
+	Features&& out,
+	SCIP* const scip,
+	SCIP_ROW* const row,
+	value_type row_norm,
+	value_type obj_norm) {
+	set_feature(out, RowFeatures::bias, scip::get_unshifted_rhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, obj_cos_sim(scip, row, row_norm, obj_norm));
 }
 
 template <typename Features>
@@ -237,9 +277,9 @@ void set_dynamic_features_for_lhs_row(
 	value_type row_norm,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_lhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = -1. * SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	set_feature(out, RowFeatures::is_tight, static_cast<value_type>(scip::is_at_lhs(scip, row)));
+	set_feature(out, RowFeatures::dual_solution_value, -1. * SCIProwGetDualsol(row) / (row_norm * obj_norm));
+	set_feature(out, RowFeatures::scaled_age, static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste));
 }
 
 template <typename Features>
@@ -250,128 +290,496 @@ void set_dynamic_features_for_rhs_row(
 	value_type row_norm,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_rhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	set_feature(out, RowFeatures::is_tight, static_cast<value_type>(scip::is_at_rhs(scip, row)));
+	set_feature(out, RowFeatures::dual_solution_value, SCIProwGetDualsol(row) / (row_norm * obj_norm));
+	set_feature(out, RowFeatures::scaled_age, static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste));
 }
 
-auto set_features_for_all_rows(xmatrix& out, scip::Model& model, bool const update_static) {
-	auto* const scip = model.get_scip_ptr();
+/****************************************
+ *  Edge features extraction functions  *
+ ****************************************/
+
+/**
+ * Write the edges of one side of a row, starting at the given non zero position.
+ *
+ * Coefficients are negated for left hand sides so that all rows are "less than" inequalities.
+ */
+template <typename Value, typename Index>
+void set_edges_for_row_side(
+	coo_matrix<Value, Index>& edges,
+	std::size_t feat_row_idx,
+	std::size_t nnz_idx,
+	SCIP_ROW* const row,
+	value_type row_norm,
+	bool negate) {
+	auto* const row_cols = SCIProwGetCols(row);
+	auto const* const row_vals = SCIProwGetVals(row);
+	auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	for (std::size_t k = 0; k < row_nnz; ++k) {
+		edges.indices(0, nnz_idx + k) = static_cast<Index>(feat_row_idx);
+		edges.indices(1, nnz_idx + k) = static_cast<Index>(SCIPcolGetVarProbindex(row_cols[k]));
+		edges.values[nnz_idx + k] = static_cast<Value>((negate ? -row_vals[k] : row_vals[k]) / row_norm);
+	}
+}
+
+/**
+ * Write the edges of one side of a row in compressed rows, starting at the given non zero position.
+ *
+ * The end of the row is written in indptr, so rows are compressed as they are written, in any order.
+ */
+template <typename Value, typename Index>
+void set_edges_for_row_side(
+	csr_matrix<Value, Index>& edges,
+	std::size_t feat_row_idx,
+	std::size_t nnz_idx,
+	SCIP_ROW* const row,
+	value_type row_norm,
+	bool negate) {
+	auto* const row_cols = SCIProwGetCols(row);
+	auto const* const row_vals = SCIProwGetVals(row);
+	auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	for (std::size_t k = 0; k < row_nnz; ++k) {
+		edges.indices[nnz_idx + k] = static_cast<Index>(SCIPcolGetVarProbindex(row_cols[k]));
+		edges.values[nnz_idx + k] = static_cast<Value>((negate ? -row_vals[k] : row_vals[k]) / row_norm);
+	}
+	edges.indptr[feat_row_idx + 1] = static_cast<Index>(nnz_idx + row_nnz);
+}
+
+/** Resize the edges, memory is only reallocated if the number of non zeros changes. */
+template <typename Value, typename Index>
+void resize_edge_features(coo_matrix<Value, Index>& edges, std::size_t n_rows, std::size_t n_vars, std::size_t nnz) {
+	edges.values.resize({nnz});
+	edges.indices.resize({2, nnz});
+	edges.shape = {n_rows, n_vars};
+}
+
+/** Resize the edges, memory is only reallocated if the number of rows or non zeros changes. */
+template <typename Value, typename Index>
+void resize_edge_features(csr_matrix<Value, Index>& edges, std::size_t n_rows, std::size_t n_vars, std::size_t nnz) {
+	edges.values.resize({nnz});
+	edges.indices.resize({nnz});
+	edges.indptr.resize({n_rows + 1});
+	edges.indptr[0] = 0;
+	edges.shape = {n_rows, n_vars};
+}
+
+/**
+ * Resize the edges in the format used, and empty the other one.
+ *
+ * Emptying does not reallocate when the edges are already empty.
+ */
+template <typename Obs>
+void resize_edge_features(Obs& obs, std::size_t n_rows, std::size_t n_vars, std::size_t nnz, bool const csr) {
+	if (csr) {
+		resize_edge_features(obs.edge_features_csr, n_rows, n_vars, nnz);
+		resize_edge_features(obs.edge_features, 0, 0, 0);
+	} else {
+		resize_edge_features(obs.edge_features, n_rows, n_vars, nnz);
+		resize_edge_features(obs.edge_features_csr, 0, 0, 0);
+	}
+}
 
-	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
-	value_type const obj_norm = obj_l2_norm(scip);
+/****************************************
+ *  Full extraction on LP rows           *
+ ****************************************/
 
-	auto feat_row_idx = std::size_t{0};
-	for (auto* const row : model.lp_rows()) {
-		auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+/**
+ * Position of each LP row in the observation.
+ *
+ * Rows are counted once per right hand side and once per left hand side, so the position of a row depends on all
+ * the previous ones.
+ * The last entries hold the total number of inequality rows and non zeros.
+ */
+struct RowOffsets {
+	std::vector<std::size_t> feat_row_idx;
+	std::vector<std::size_t> nnz_idx;
+
+	[[nodiscard]] auto n_ineq_rows() const noexcept { return feat_row_idx.back(); }
+	[[nodiscard]] auto nnz() const noexcept { return nnz_idx.back(); }
+};
+
+auto compute_row_offsets(SCIP* const scip, nonstd::span<SCIP_ROW*> const rows) -> RowOffsets {
+	auto offsets = RowOffsets{};
+	offsets.feat_row_idx.resize(rows.size() + 1);
+	offsets.nnz_idx.resize(rows.size() + 1);
+	offsets.feat_row_idx[0] = 0;
+	offsets.nnz_idx[0] = 0;
+	for (std::size_t row_idx = 0; row_idx < rows.size(); ++row_idx) {
+		auto* const row = rows[row_idx];
+		auto const n_sides = static_cast<std::size_t>(scip::get_unshifted_lhs(scip, row).has_value()) +
+		                     static_cast<std::size_t>(scip::get_unshifted_rhs(scip, row).has_value());
+		offsets.feat_row_idx[row_idx + 1] = offsets.feat_row_idx[row_idx] + n_sides;
+		offsets.nnz_idx[row_idx + 1] =
+			offsets.nnz_idx[row_idx] + n_sides * static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	}
+	return offsets;
+}
+
+/**
+ * Write the features of the LP rows in [row_begin, row_end), and their edges if update_static is set.
+ *
+ * Edges are written in compressed rows if csr is set, and in coordinate format otherwise.
+ * Rows are written at the position given by the offsets, so that ranges of rows are independent.
+ */
+template <typename Obs>
+void set_features_for_rows(
+	Obs& obs,
+	SCIP* const scip,
+	nonstd::span<SCIP_ROW*> const rows,
+	nonstd::span<SCIP_Real const> const row_norms,
+	RowOffsets const& offsets,
+	std::size_t row_begin,
+	std::size_t row_end,
+	bool const update_static,
+	bool const csr,
+	value_type obj_norm,
+	value_type n_lps) {
+	auto const set_edges = [&](auto... args) {
+		if (csr) {
+			set_edges_for_row_side(obs.edge_features_csr, args...);
+		} else {
+			set_edges_for_row_side(obs.edge_features, args...);
+		}
+	};
+	for (std::size_t row_idx = row_begin; row_idx < row_end; ++row_idx) {
+		auto* const row = rows[row_idx];
+		auto const row_norm = static_cast<value_type>(row_l2_norm(row_norms[row_idx]));
+		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+		auto feat_row_idx = offsets.feat_row_idx[row_idx];
+		auto nnz_idx = offsets.nnz_idx[row_idx];
 
-		// Rows are counted once per rhs and once per lhs
 		if (scip::get_unshifted_lhs(scip, row).has_value()) {
-			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
+			auto features = xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx));
 			if (update_static) {
-				set_static_features_for_lhs_row(features, scip, row, row_norm);
+				set_static_features_for_lhs_row(features, scip, row, row_norm, obj_norm);
+				set_edges(feat_row_idx, nnz_idx, row, row_norm, true);
 			}
 			set_dynamic_features_for_lhs_row(features, scip, row, row_norm, obj_norm, n_lps);
 			feat_row_idx++;
+			nnz_idx += row_nnz;
 		}
 		if (scip::get_unshifted_rhs(scip, row).has_value()) {
-			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
+			auto features = xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx));
 			if (update_static) {
-				set_static_features_for_rhs_row(features, scip, row, row_norm);
+				set_static_features_for_rhs_row(features, scip, row, row_norm, obj_norm);
+				set_edges(feat_row_idx, nnz_idx, row, row_norm, false);
 			}
 			set_dynamic_features_for_rhs_row(features, scip, row, row_norm, obj_norm, n_lps);
-			feat_row_idx++;
 		}
 	}
-	assert(feat_row_idx == n_ineq_rows(model));
 }
 
-/****************************************
- *  Edge features extraction functions  *
- ****************************************/
-
 /**
- * Number of non zero element in the constraint matrix.
+ * Write the features of all variables and rows, splitting the work in n_threads contiguous ranges.
  *
- * Row are counted once per right hand side and once per left hand side.
+ * Variables are split evenly, and rows are split so that each range holds a similar number of non zeros.
+ * Every entry is computed the same way regardless of the number of threads, so the result does not depend on it.
  */
-auto matrix_nnz(scip::Model& model) {
+template <typename Obs>
+void set_features_concurrently(
+	Obs& obs,
+	scip::Model& model,
+	RowOffsets const& offsets,
+	bool const update_static,
+	bool const csr,
+	std::size_t n_threads,
+	data::StepContext& context) {
 	auto* const scip = model.get_scip_ptr();
-	std::size_t nnz = 0;
-	for (auto* row : model.lp_rows()) {
-		auto const row_size = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
-		if (scip::get_unshifted_lhs(scip, row).has_value()) {
-			nnz += row_size;
-		}
-		if (scip::get_unshifted_rhs(scip, row).has_value()) {
-			nnz += row_size;
+	auto const variables = model.variables();
+	auto const rows = model.lp_rows();
+	auto const row_norms = context.lp_row_norms(model);
+
+	// Contant reused in every iterations
+	auto const n_lps = static_cast<value_type>(context.n_lps(model));
+	auto const obj_norm = obj_l2_norm(model, context);
+
+	auto n_chunks = std::max(n_threads, std::size_t{1});
+	if ((n_chunks > 1) && !context.prepare_concurrent_reads(model)) {
+		// Some quantities that SCIP computes lazily could not be computed beforehand
+		n_chunks = 1;
+	}
+	auto const var_bound = [&](std::size_t chunk) { return variables.size() * chunk / n_chunks; };
+	auto const row_bound = [&](std::size_t chunk) {
+		if (chunk == n_chunks) {
+			return rows.size();
 		}
+		auto const nnz_target = offsets.nnz() * chunk / n_chunks;
+		auto const first = std::lower_bound(offsets.nnz_idx.begin(), offsets.nnz_idx.end() - 1, nnz_target);
+		return static_cast<std::size_t>(first - offsets.nnz_idx.begin());
+	};
+
+	auto tasks = std::vector<std::function<void()>>{};
+	tasks.reserve(n_chunks);
+	for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+		auto const var_begin = var_bound(chunk);
+		auto const var_end = var_bound(chunk + 1);
+		auto const row_begin = row_bound(chunk);
+		auto const row_end = row_bound(chunk + 1);
+		tasks.emplace_back([&, var_begin, var_end, row_begin, row_end]() {
+			set_features_for_vars(
+				obs.variable_features, scip, variables, var_begin, var_end, update_static, obj_norm, n_lps);
+			set_features_for_rows(
+				obs, scip, rows, row_norms, offsets, row_begin, row_end, update_static, csr, obj_norm, n_lps);
+		});
 	}
-	return nnz;
+	// With a single chunk, the task runs directly on this thread
+	data::internal::run_concurrently(tasks);
 }
 
-utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
+/** Whether the arrays written by an extraction have the shapes for the given number of variables, rows, and edges. */
+template <typename Obs>
+auto has_shapes(Obs const& obs, std::size_t n_vars, std::size_t n_rows, std::size_t nnz, bool csr) -> bool {
+	using Shape1 = std::array<std::size_t, 1>;
+	using Shape2 = std::array<std::size_t, 2>;
+	if ((obs.variable_features.shape() != Shape2{n_vars, Obs::n_variable_features}) ||
+	    (obs.row_features.shape() != Shape2{n_rows, Obs::n_row_features})) {
+		return false;
+	}
+	if (csr) {
+		// Coordinate edges are emptied
+		return (obs.edge_features.values.size() == 0) && (obs.edge_features.indices.size() == 0) &&
+		       (obs.edge_features_csr.values.shape() == Shape1{nnz}) &&
+		       (obs.edge_features_csr.indices.shape() == Shape1{nnz}) &&
+		       (obs.edge_features_csr.indptr.shape() == Shape1{n_rows + 1});
+	}
+	return (obs.edge_features.values.shape() == Shape1{nnz}) && (obs.edge_features.indices.shape() == Shape2{2, nnz});
+}
+
+auto is_on_root_node(scip::Model& model) -> bool {
 	auto* const scip = model.get_scip_ptr();
+	return SCIPgetCurrentNode(scip) == SCIPgetRootNode(scip);
+}
 
-	using coo_matrix = utility::coo_matrix<value_type>;
-	auto const nnz = matrix_nnz(model);
-	auto values = decltype(coo_matrix::values)::from_shape({nnz});
-	auto indices = decltype(coo_matrix::indices)::from_shape({2, nnz});
-
-	std::size_t i = 0;
-	std::size_t j = 0;
-	for (auto* const row : model.lp_rows()) {
-		auto const row_norm = static_cast<value_type>(row_l2_norm(row));
-		auto* const row_cols = SCIProwGetCols(row);
-		auto const* const row_vals = SCIProwGetVals(row);
-		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
-		if (scip::get_unshifted_lhs(scip, row).has_value()) {
-			for (std::size_t k = 0; k < row_nnz; ++k) {
-				indices(0, j + k) = i;
-				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = -row_vals[k] / row_norm;
-			}
-			j += row_nnz;
-			i++;
-		}
-		if (scip::get_unshifted_rhs(scip, row).has_value()) {
-			for (std::size_t k = 0; k < row_nnz; ++k) {
-				indices(0, j + k) = i;
-				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = row_vals[k] / row_norm;
-			}
-			j += row_nnz;
-			i++;
-		}
+template <typename Obs>
+void extract_observation_fully(
+	scip::Model& model,
+	Obs& obs,
+	bool const csr,
+	std::size_t n_threads,
+	data::StepContext& context) {
+	auto const offsets = compute_row_offsets(model.get_scip_ptr(), model.lp_rows());
+	auto const n_vars = model.variables().size();
+	obs.variable_features.resize({n_vars, Obs::n_variable_features});
+	obs.row_features.resize({offsets.n_ineq_rows(), Obs::n_row_features});
+	resize_edge_features(obs, offsets.n_ineq_rows(), n_vars, offsets.nnz(), csr);
+	set_features_concurrently(obs, model, offsets, true, csr, n_threads, context);
+}
+
+template <typename Obs>
+void extract_observation_from_cache(
+	scip::Model& model,
+	Obs const& cache,
+	Obs& obs,
+	std::size_t n_threads,
+	data::StepContext& context) {
+	// Assignments do not reallocate when the shapes are unchanged.
+	obs = cache;
+	auto const offsets = compute_row_offsets(model.get_scip_ptr(), model.lp_rows());
+	// Only dynamic features are written, so the format of the edges does not matter
+	set_features_concurrently(obs, model, offsets, false, false, n_threads, context);
+}
+
+/****************************************
+ *  Incremental extraction on LP rows   *
+ ****************************************/
+
+/**
+ * Event handler recording when LP rows are added to the LP or modified.
+ *
+ * Each event increments a counter, whose value is stored for the row concerned, so that any number of observation
+ * functions can query the rows changed since their last extraction.
+ */
+class RowEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr base_name = "ecole::observation::NodeBipartiteRowEventHandler";
+
+	RowEventHandler(SCIP* scip, char const* name_) :
+		ObjEventhdlr(scip, name_, "Event handler for rows added to the LP or modified") {}
+
+	~RowEventHandler() override = default;
+
+	/** Number of events reported so far. */
+	[[nodiscard]] auto n_events() const noexcept -> std::uint64_t { return events_count; }
+
+	/** Whether the row was added to the LP or modified after the given number of events. */
+	[[nodiscard]] auto changed_since(SCIP_ROW* const row, std::uint64_t n_events_before) const noexcept -> bool {
+		auto const idx = static_cast<std::size_t>(SCIProwGetIndex(row));
+		return (idx >= last_events.size()) || (last_events[idx] == 0) || (last_events[idx] > n_events_before);
 	}
 
-	auto const n_rows = n_ineq_rows(model);
-	// Change this here for variables
-	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	return {values, indices, {n_rows, n_vars}};
+	/** Catch rows added to the LP. */
+	SCIP_RETCODE scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override;
+	/** Drop rows added to the LP. */
+	SCIP_RETCODE scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override;
+	/** Record the event on its row, and catch the modifications of rows entering the LP for the first time. */
+	SCIP_RETCODE
+	scip_exec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* eventdata) override;
+
+private:
+	std::uint64_t events_count = 0;
+	/** Value of the counter at the last event of each row, by row index, zero for rows never seen. */
+	std::vector<std::uint64_t> last_events;
+};
+
+auto RowEventHandler::scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+	SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_ROWADDEDLP, eventhdlr, nullptr, nullptr));
+	return SCIP_OKAY;
 }
 
-auto is_on_root_node(scip::Model& model) -> bool {
+auto RowEventHandler::scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+	SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_ROWADDEDLP, eventhdlr, nullptr, -1));
+	return SCIP_OKAY;
+}
+
+auto RowEventHandler::scip_exec(
+	SCIP* scip,
+	SCIP_EVENTHDLR* eventhdlr,
+	SCIP_EVENT* event,
+	SCIP_EVENTDATA* /*eventdata*/) -> SCIP_RETCODE {
+	auto* const row = SCIPeventGetRow(event);
+	auto const idx = static_cast<std::size_t>(SCIProwGetIndex(row));
+	if (idx >= last_events.size()) {
+		last_events.resize(idx + 1, 0);
+	}
+	if ((SCIPeventGetType(event) == SCIP_EVENTTYPE_ROWADDEDLP) && (last_events[idx] == 0)) {
+		// Modifications are caught for the whole life of the row, since it may leave and enter the LP again
+		SCIP_CALL(SCIPcatchRowEvent(scip, row, SCIP_EVENTTYPE_ROWCHANGED, eventhdlr, nullptr, nullptr));
+	}
+	last_events[idx] = ++events_count;
+	return SCIP_OKAY;
+}
+
+auto make_row_events_name() -> std::string {
+	static auto counter = std::atomic<std::size_t>{0};
+	return RowEventHandler::base_name + std::to_string(counter++);
+}
+
+/** Add the row event handler to the model, unless it is already there, for instance from a copied function. */
+void add_row_eventhdlr(scip::Model& model, std::string const& name) {
 	auto* const scip = model.get_scip_ptr();
-	return SCIPgetCurrentNode(scip) == SCIPgetRootNode(scip);
+	// Plugins can only be included before the problem is transformed
+	if ((SCIPgetStage(scip) > SCIP_STAGE_PROBLEM) || (SCIPfindObjEventhdlr(scip, name.c_str()) != nullptr)) {
+		return;
+	}
+	auto handler = std::make_unique<RowEventHandler>(scip, name.c_str());
+	scip::call(SCIPincludeObjEventhdlr, scip, handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
 }
 
-auto extract_observation_fully(scip::Model& model) -> NodeBipartiteObs {
-	auto obs = NodeBipartiteObs{
-		// Change this here for variables
-		xmatrix::from_shape({model.variables().size(), NodeBipartiteObs::n_variable_features}),
-		xmatrix::from_shape({n_ineq_rows(model), NodeBipartiteObs::n_row_features}),
-		extract_edge_features(model),
+/** Return the row event handler, or null if it is not in the model, in which case all rows count as modified. */
+auto get_row_eventhdlr(scip::Model& model, std::string const& name) -> RowEventHandler const* {
+	if (name.empty()) {
+		return nullptr;
+	}
+	return dynamic_cast<RowEventHandler const*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str()));
+}
+
+template <typename Signature>
+auto make_row_signature(SCIP* const scip, SCIP_ROW* const row, std::size_t feat_row_idx, std::size_t nnz_idx)
+	-> Signature {
+	return {
+		SCIProwGetIndex(row),
+		SCIProwGetNLPNonz(row),
+		scip::get_unshifted_lhs(scip, row).has_value(),
+		scip::get_unshifted_rhs(scip, row).has_value(),
+		row->lpcolssorted != 0U,
+		feat_row_idx,
+		nnz_idx,
 	};
-	set_features_for_all_vars(obs.variable_features, model, true);
-	set_features_for_all_rows(obs.row_features, model, true);
-	return obs;
 }
 
-auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) -> NodeBipartiteObs {
-	set_features_for_all_vars(obs.variable_features, model, false);
-	set_features_for_all_rows(obs.row_features, model, false);
-	return obs;
+/** Whether two signatures are for the same row with the same coefficients layout, regardless of its position. */
+template <typename Signature> auto same_row(Signature const& sig1, Signature const& sig2) noexcept -> bool {
+	return (sig1.index == sig2.index) && (sig1.n_lp_nonz == sig2.n_lp_nonz) && (sig1.has_lhs == sig2.has_lhs) &&
+	       (sig1.has_rhs == sig2.has_rhs) && (sig1.lp_cols_sorted == sig2.lp_cols_sorted);
+}
+
+template <typename Signature> auto n_sides_of(Signature const& sig) noexcept -> std::size_t {
+	return static_cast<std::size_t>(sig.has_lhs) + static_cast<std::size_t>(sig.has_rhs);
+}
+
+/** Write the static features and edges of all the sides of a row at the position given by its signature. */
+template <typename Obs, typename Signature>
+void set_static_features_and_edges_for_row(
+	Obs& obs,
+	SCIP* const scip,
+	SCIP_ROW* const row,
+	Signature const& sig,
+	value_type row_norm,
+	value_type obj_norm) {
+	auto feat_row_idx = sig.feat_row_idx;
+	auto nnz_idx = sig.nnz_idx;
+	if (sig.has_lhs) {
+		set_static_features_for_lhs_row(
+			xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx)), scip, row, row_norm, obj_norm);
+		set_edges_for_row_side(obs.edge_features, feat_row_idx, nnz_idx, row, row_norm, true);
+		feat_row_idx++;
+		nnz_idx += static_cast<std::size_t>(sig.n_lp_nonz);
+	}
+	if (sig.has_rhs) {
+		set_static_features_for_rhs_row(
+			xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx)), scip, row, row_norm, obj_norm);
+		set_edges_for_row_side(obs.edge_features, feat_row_idx, nnz_idx, row, row_norm, false);
+	}
+}
+
+/**
+ * Copy the static features and edges of all the sides of a row from another observation.
+ *
+ * The features and edges of a row are contiguous blocks, only the row indices of the edges are shifted.
+ */
+template <typename Obs, typename Signature>
+void copy_static_features_and_edges_for_row(
+	Obs const& from,
+	Signature const& from_sig,
+	Obs& to,
+	Signature const& to_sig) {
+	using Index = typename decltype(to.edge_features)::index_type;
+	auto const n_row_feats = Obs::n_row_features;
+	auto const row_nnz = static_cast<std::size_t>(to_sig.n_lp_nonz);
+	for (std::size_t side = 0; side < n_sides_of(to_sig); ++side) {
+		std::copy_n(
+			from.row_features.data() + (from_sig.feat_row_idx + side) * n_row_feats,
+			Obs::n_static_row_features,
+			to.row_features.data() + (to_sig.feat_row_idx + side) * n_row_feats);
+		std::fill_n(
+			to.edge_features.indices.data() + to_sig.nnz_idx + side * row_nnz,
+			row_nnz,
+			static_cast<Index>(to_sig.feat_row_idx + side));
+	}
+	auto const block_nnz = n_sides_of(to_sig) * row_nnz;
+	// Column indices are on the second line of the indices matrix
+	std::copy_n(
+		from.edge_features.indices.data() + from.edge_features.nnz() + from_sig.nnz_idx,
+		block_nnz,
+		to.edge_features.indices.data() + to.edge_features.nnz() + to_sig.nnz_idx);
+	std::copy_n(
+		from.edge_features.values.data() + from_sig.nnz_idx,
+		block_nnz,
+		to.edge_features.values.data() + to_sig.nnz_idx);
+}
+
+/** Write the dynamic features of all the sides of a row at the position given by its signature. */
+template <typename Obs, typename Signature>
+void set_dynamic_features_for_row(
+	Obs& obs,
+	SCIP* const scip,
+	SCIP_ROW* const row,
+	Signature const& sig,
+	value_type row_norm,
+	value_type obj_norm,
+	value_type n_lps) {
+	auto feat_row_idx = sig.feat_row_idx;
+	if (sig.has_lhs) {
+		set_dynamic_features_for_lhs_row(
+			xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx)), scip, row, row_norm, obj_norm, n_lps);
+		feat_row_idx++;
+	}
+	if (sig.has_rhs) {
+		set_dynamic_features_for_rhs_row(
+			xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feat_row_idx)), scip, row, row_norm, obj_norm, n_lps);
+	}
 }
 
 }  // namespace
@@ -380,25 +788,196 @@ auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) ->
  *  Observation extracting function  *
  *************************************/
 
-auto NodeBipartite::before_reset(scip::Model& /* model */) -> void {
-	cache_computed = false;
-}
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract_observation_incrementally(
+	scip::Model& model,
+	Observation& obs,
+	data::StepContext& context) -> void {
+	auto* const scip = model.get_scip_ptr();
+	auto const rows = model.lp_rows();
+	auto const row_norms = context.lp_row_norms(model);
+	auto const* const row_events = get_row_eventhdlr(model, row_events_name);
+
+	// Only the sizes of the rows are read, not their coefficients
+	auto signatures = std::vector<RowSignature>{};
+	signatures.reserve(rows.size());
+	std::size_t n_feat_rows = 0;
+	std::size_t nnz = 0;
+	for (auto* const row : rows) {
+		auto const& sig = signatures.emplace_back(make_row_signature<RowSignature>(scip, row, n_feat_rows, nnz));
+		n_feat_rows += n_sides_of(sig);
+		nnz += n_sides_of(sig) * static_cast<std::size_t>(sig.n_lp_nonz);
+	}
+	auto const is_modified = [&](SCIP_ROW* const row) {
+		return !cache_computed || (row_events == nullptr) || row_events->changed_since(row, n_row_events);
+	};
 
-auto NodeBipartite::extract(scip::Model& model, bool /* done */) -> std::optional<NodeBipartiteObs> {
-	if (model.stage() == SCIP_STAGE_SOLVING) {
-		if (use_cache) {
-			if (is_on_root_node(model)) {
-				the_cache = extract_observation_fully(model);
-				cache_computed = true;
-				return the_cache;
+	auto const n_vars = model.variables().size();
+	auto const n_lps = static_cast<value_type>(context.n_lps(model));
+	auto const obj_norm = static_cast<value_type>(obj_l2_norm(model, context));
+	// Variables do not change during solving so their static features are computed once.
+	if (!cache_computed) {
+		the_cache.variable_features.resize({n_vars, Observation::n_variable_features});
+	}
+	set_features_for_all_vars(the_cache.variable_features, model, !cache_computed, context);
+
+	auto const same_rows = cache_computed && std::equal(
+		signatures.begin(), signatures.end(), row_signatures.begin(), row_signatures.end(), same_row<RowSignature>);
+	if (same_rows) {
+		// Rows are at the same position as in the cache, only the modified ones are written again
+		for (std::size_t row_idx = 0; row_idx < rows.size(); ++row_idx) {
+			if (is_modified(rows[row_idx])) {
+				auto const row_norm = static_cast<value_type>(row_l2_norm(row_norms[row_idx]));
+				set_static_features_and_edges_for_row(
+					the_cache, scip, rows[row_idx], signatures[row_idx], row_norm, obj_norm);
 			}
-			if (cache_computed) {
-				return extract_observation_from_cache(model, the_cache);
+		}
+	} else {
+		// Rows are rebuilt in the scratch buffer, copying from the cache the ones that were not modified
+		scratch.row_features.resize({n_feat_rows, Observation::n_row_features});
+		resize_edge_features(scratch.edge_features, n_feat_rows, n_vars, nnz);
+		for (std::size_t sig_idx = 0; sig_idx < row_signatures.size(); ++sig_idx) {
+			auto const idx = static_cast<std::size_t>(row_signatures[sig_idx].index);
+			if (idx >= previous_rows.size()) {
+				previous_rows.resize(idx + 1, 0);
+			}
+			previous_rows[idx] = sig_idx + 1;
+		}
+		for (std::size_t row_idx = 0; row_idx < rows.size(); ++row_idx) {
+			auto const& sig = signatures[row_idx];
+			auto const idx = static_cast<std::size_t>(sig.index);
+			auto const previous = idx < previous_rows.size() ? previous_rows[idx] : 0;
+			if ((previous > 0) && same_row(row_signatures[previous - 1], sig) && !is_modified(rows[row_idx])) {
+				copy_static_features_and_edges_for_row(the_cache, row_signatures[previous - 1], scratch, sig);
+			} else {
+				auto const row_norm = static_cast<value_type>(row_l2_norm(row_norms[row_idx]));
+				set_static_features_and_edges_for_row(scratch, scip, rows[row_idx], sig, row_norm, obj_norm);
 			}
 		}
-		return extract_observation_fully(model);
+		for (auto const& sig : row_signatures) {
+			previous_rows[static_cast<std::size_t>(sig.index)] = 0;
+		}
+		std::swap(the_cache.row_features, scratch.row_features);
+		std::swap(the_cache.edge_features, scratch.edge_features);
+	}
+
+	for (std::size_t row_idx = 0; row_idx < rows.size(); ++row_idx) {
+		auto const row_norm = static_cast<value_type>(row_l2_norm(row_norms[row_idx]));
+		set_dynamic_features_for_row(the_cache, scip, rows[row_idx], signatures[row_idx], row_norm, obj_norm, n_lps);
+	}
+
+	row_signatures = std::move(signatures);
+	n_row_events = (row_events != nullptr) ? row_events->n_events() : 0;
+	cache_computed = true;
+	// Assignments do not reallocate when the shapes are unchanged.
+	obs.variable_features = the_cache.variable_features;
+	obs.row_features = the_cache.row_features;
+	if (use_csr) {
+		// The cache stays in coordinate format, which unmodified rows are copied from as contiguous blocks
+		utility::coo_to_csr(the_cache.edge_features, obs.edge_features_csr);
+		resize_edge_features(obs.edge_features, 0, 0, 0);
+	} else {
+		obs.edge_features = the_cache.edge_features;
 	}
-	return {};
 }
 
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::before_reset(scip::Model& model) -> void {
+	cache_computed = false;
+	row_signatures.clear();
+	if (use_incremental) {
+		if (row_events_name.empty()) {
+			row_events_name = make_row_events_name();
+		}
+		add_row_eventhdlr(model, row_events_name);
+	}
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract(scip::Model& model, bool done) -> std::optional<Observation> {
+	auto context = data::StepContext{};
+	return extract_in_context(model, done, context);
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract_in_context(scip::Model& model, bool done, data::StepContext& context)
+	-> std::optional<Observation> {
+	auto obs = std::optional<Observation>{};
+	extract_into(model, done, obs, context);
+	return obs;
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract_into(scip::Model& model, bool done, std::optional<Observation>& obs)
+	-> void {
+	auto context = data::StepContext{};
+	extract_into(model, done, obs, context);
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract_into(
+	scip::Model& model,
+	bool done,
+	std::optional<Observation>& obs,
+	data::StepContext& context) -> void {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		obs.reset();
+		return;
+	}
+	if (!obs.has_value()) {
+		obs.emplace();
+	}
+	extract_into(model, done, obs.value(), context);
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::extract_into(
+	scip::Model& model,
+	bool /* done */,
+	Observation& obs,
+	data::StepContext& context) -> bool {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return false;
+	}
+	if (use_incremental) {
+		extract_observation_incrementally(model, obs, context);
+	} else if (use_cache && is_on_root_node(model)) {
+		extract_observation_fully(model, the_cache, use_csr, n_threads, context);
+		cache_computed = true;
+		obs = the_cache;
+	} else if (use_cache && cache_computed) {
+		extract_observation_from_cache(model, the_cache, obs, n_threads, context);
+	} else {
+		extract_observation_fully(model, obs, use_csr, n_threads, context);
+	}
+	return true;
+}
+
+template <typename Value, typename Index>
+auto BasicNodeBipartite<Value, Index>::keeps_shapes_of(
+	scip::Model& model,
+	Observation const& obs,
+	data::StepContext& /* context */) const -> bool {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return false;
+	}
+	auto const n_vars = model.variables().size();
+	auto n_rows = std::size_t{0};
+	auto nnz = std::size_t{0};
+	if (!use_incremental && use_cache && cache_computed && !is_on_root_node(model)) {
+		// Rows and edges are copied from the cache
+		n_rows = the_cache.row_features.shape(0);
+		nnz = use_csr ? the_cache.edge_features_csr.nnz() : the_cache.edge_features.nnz();
+	} else {
+		auto const offsets = compute_row_offsets(model.get_scip_ptr(), model.lp_rows());
+		n_rows = offsets.n_ineq_rows();
+		nnz = offsets.nnz();
+	}
+	return has_shapes(obs, n_vars, n_rows, nnz, use_csr);
+}
+
+template class BasicNodeBipartite<double, std::size_t>;
+template class BasicNodeBipartite<float, std::int32_t>;
+template class BasicNodeBipartite<float, std::int64_t>;
+
 }  // namespace ecole::observation
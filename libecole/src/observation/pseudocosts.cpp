@@ -2,53 +2,67 @@
 #include <cstddef>
 #include <optional>
 
-#include <nonstd/span.hpp>
-#include <range/v3/view/zip.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
+#include "ecole/data/step-context.hpp"
 #include "ecole/observation/pseudocosts.hpp"
 #include "ecole/scip/model.hpp"
 
 namespace ecole::observation {
 
-namespace views = ranges::views;
+Pseudocosts::Pseudocosts(bool candidates_only_) noexcept : candidates_only{candidates_only_} {}
 
-namespace {
+std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, bool done) {
+	auto context = data::StepContext{};
+	return extract_in_context(model, done, context);
+}
 
-/** Get LP branching candidates variables and LP solution values. */
-auto scip_get_lp_branch_cands(SCIP* const scip) noexcept {
-	SCIP_VAR** cands = nullptr;
-	SCIP_Real* cands_lp_values = nullptr;
-	int n_cands = 0;
-	SCIPgetLPBranchCands(scip, &cands, &cands_lp_values, nullptr, nullptr, &n_cands, nullptr);
-	return std::tuple{
-		nonstd::span{cands, static_cast<std::size_t>(n_cands)},
-		nonstd::span{cands_lp_values, static_cast<std::size_t>(n_cands)},
-	};
+std::optional<xt::xtensor<double, 1>> Pseudocosts::extract_in_context(
+	scip::Model& model,
+	bool done,
+	data::StepContext& context) {
+	auto pseudocosts = std::optional<xt::xtensor<double, 1>>{};
+	extract_into(model, done, pseudocosts, context);
+	return pseudocosts;
 }
 
-}  // namespace
+void Pseudocosts::extract_into(scip::Model& model, bool done, std::optional<xt::xtensor<double, 1>>& obs) {
+	auto context = data::StepContext{};
+	extract_into(model, done, obs, context);
+}
 
-std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, bool /* done */) {
+void Pseudocosts::extract_into(
+	scip::Model& model,
+	bool /* done */,
+	std::optional<xt::xtensor<double, 1>>& obs,
+	data::StepContext& context) {
 	if (model.stage() != SCIP_STAGE_SOLVING) {
-		return {};
+		obs.reset();
+		return;
 	}
 
 	auto* const scip = model.get_scip_ptr();
-	auto const [cands, lp_values] = scip_get_lp_branch_cands(scip);
+	auto const& cands = context.lp_branch_cands(model);
+	auto const n_cands = cands.variables.size();
 
 	/* Store pseudocosts in tensor */
-	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	xt::xtensor<double, 1> pseudocosts({nb_vars}, std::nan(""));
-
-	for (auto const [var, lp_val] : views::zip(cands, lp_values)) {
-		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
-		auto const score = SCIPgetVarPseudocostScore(scip, var, lp_val);
-		pseudocosts[var_index] = static_cast<double>(score);
+	if (!obs.has_value()) {
+		obs.emplace();
+	}
+	auto& pseudocosts = obs.value();
+	if (candidates_only) {
+		pseudocosts.resize({n_cands});
+	} else {
+		pseudocosts.resize({static_cast<std::size_t>(SCIPgetNVars(scip))});
+		pseudocosts.fill(std::nan(""));
 	}
 
-	return pseudocosts;
+	for (std::size_t cand_idx = 0; cand_idx < n_cands; ++cand_idx) {
+		auto const score = SCIPgetVarPseudocostScore(scip, cands.variables[cand_idx], cands.lp_values[cand_idx]);
+		auto const out_idx = candidates_only ? cand_idx : cands.indices[cand_idx];
+		pseudocosts[out_idx] = static_cast<double>(score);
+	}
 }
 
 }  // namespace ecole::observation
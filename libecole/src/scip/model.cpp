@@ -6,6 +6,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <fmt/format.h>
 #include <range/v3/view/move.hpp>
@@ -39,15 +40,19 @@ SCIP* Model::get_scip_ptr() noexcept {
 	return scimpl->get_scip_ptr();
 }
 SCIP const* Model::get_scip_ptr() const noexcept {
-	return scimpl->get_scip_ptr();
+	return std::as_const(*scimpl).get_scip_ptr();
 }
 
 Model Model::copy() const {
-	return std::make_unique<Scimpl>(scimpl->copy());
+	auto model = Model{std::make_unique<Scimpl>(scimpl->copy())};
+	model.set_coroutine_backend(coroutine_backend());
+	return model;
 }
 
 Model Model::copy_orig() const {
-	return std::make_unique<Scimpl>(scimpl->copy_orig());
+	auto model = Model{std::make_unique<Scimpl>(scimpl->copy_orig())};
+	model.set_coroutine_backend(coroutine_backend());
+	return model;
 }
 
 bool Model::operator==(Model const& other) const noexcept {
@@ -294,6 +299,14 @@ SCIP_Real Model::dual_bound() const noexcept {
 	}
 }
 
+utility::CoroutineBackend Model::coroutine_backend() const noexcept {
+	return scimpl->coroutine_backend();
+}
+
+void Model::set_coroutine_backend(utility::CoroutineBackend backend) noexcept {
+	scimpl->set_coroutine_backend(backend);
+}
+
 auto Model::solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 	-> std::optional<callback::DynamicCall> {
 	return scimpl->solve_iter(arg_packs);
@@ -307,4 +320,13 @@ auto Model::solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::D
 	return scimpl->solve_iter_continue(result);
 }
 
+auto Model::solve_direct(nonstd::span<callback::DynamicConstructor const> arg_packs, callback::DirectHandler handler)
+	-> void {
+	scimpl->solve_direct(arg_packs, std::move(handler));
+}
+
+auto Model::solve_direct(callback::DynamicConstructor arg_pack, callback::DirectHandler handler) -> void {
+	solve_direct({&arg_pack, 1}, std::move(handler));
+}
+
 }  // namespace ecole::scip
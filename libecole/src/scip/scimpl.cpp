@@ -1,11 +1,19 @@
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
 #include <mutex>
 #include <scip/type_result.h>
 #include <scip/type_retcode.h>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <objscip/objbranchrule.h>
 #include <objscip/objheur.h>
@@ -18,6 +26,7 @@
 #include "ecole/scip/scimpl.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/coroutine.hpp"
+#include "ecole/utility/unreachable.hpp"
 
 namespace ecole::scip {
 
@@ -30,13 +39,23 @@ namespace {
 using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT>;
 using Executor = typename Controller::Executor;
 
+/**
+ * Destination of the calls made by reverse callbacks.
+ *
+ * Calls are either sent to the iterative solving executor, or, in direct mode, handled in place by a function.
+ */
+struct CallHandler {
+	std::weak_ptr<Executor> executor;
+	callback::DirectHandler direct;
+};
+
 /**
  * Function to add a callback to SCIP.
  *
  * Needs to be implemented by all reverse callbacks.
  */
 template <callback::Type type>
-auto include_reverse_callback(SCIP* scip, std::weak_ptr<Executor> executor, callback::Constructor<type> args) -> void;
+auto include_reverse_callback(SCIP* scip, CallHandler handler, callback::Constructor<type> args) -> void;
 
 /**
  * In a callback send Callback type and wait for result.
@@ -67,22 +86,35 @@ auto handle_executor(SCIP* scip, std::weak_ptr<Executor>& weak_executor, callbac
 	}
 }
 
+/** In a callback, forward the call to the direct handler if there is one, otherwise to the executor. */
+template <callback::Type type>
+auto handle_call(SCIP* scip, CallHandler& handler, callback::Call<type> call) noexcept
+	-> std::tuple<SCIP_RETCODE, SCIP_RESULT> {
+	if (handler.direct) {
+		try {
+			return {SCIP_OKAY, handler.direct(call)};
+		} catch (...) {
+			// The exception is saved by the handler and rethrown after SCIP stops, see Scimpl::solve_direct.
+			return {SCIP_ERROR, SCIP_DIDNOTRUN};
+		}
+	}
+	return handle_executor(scip, handler.executor, call);
+}
+
 class ReverseBranchrule : public ::scip::ObjBranchrule {
 public:
-	ReverseBranchrule(
-		SCIP* scip,
-		int priority,
-		int maxdepth,
-		SCIP_Real maxbounddist,
-		std::weak_ptr<Executor> weak_executor) :
+	ReverseBranchrule(SCIP* scip, callback::BranchruleConstructor args, CallHandler handler) :
 		ObjBranchrule{
 			scip,
 			name(callback::Type::Branchrule),
 			"Branchrule that wait for another thread to make the branching.",
-			priority,
-			maxdepth,
-			maxbounddist},
-		m_weak_executor{std::move(weak_executor)} {}
+			args.priority,
+			args.max_depth,
+			args.max_bound_distance},
+		m_handler{std::move(handler)},
+		m_pause_on_lp{args.pause_on_lp},
+		m_pause_on_external{args.pause_on_external},
+		m_pause_on_pseudo{args.pause_on_pseudo} {}
 
 	/** branching execution method for fractional LP solutions
 	 *
@@ -158,11 +190,33 @@ public:
 	}
 
 private:
-	std::weak_ptr<Executor> m_weak_executor;
+	CallHandler m_handler;
+	bool m_pause_on_lp;
+	bool m_pause_on_external;
+	bool m_pause_on_pseudo;
+
+	[[nodiscard]] auto pauses_on(callback::BranchruleCall::Where where) const noexcept -> bool {
+		using Where = callback::BranchruleCall::Where;
+		switch (where) {
+		case Where::LP:
+			return m_pause_on_lp;
+		case Where::External:
+			return m_pause_on_external;
+		case Where::Pseudo:
+			return m_pause_on_pseudo;
+		default:
+			utility::unreachable();
+		}
+	}
 
 	auto scip_exec_any(SCIP* scip, SCIP_RESULT* result, callback::BranchruleCall call) -> SCIP_RETCODE {
+		// Filtered in the solving thread to avoid a round trip with the controller.
+		if (!pauses_on(call.where)) {
+			*result = SCIP_DIDNOTRUN;
+			return SCIP_OKAY;
+		}
 		auto retcode = SCIP_OKAY;
-		std::tie(retcode, *result) = handle_executor(scip, m_weak_executor, call);
+		std::tie(retcode, *result) = handle_call(scip, m_handler, call);
 		return retcode;
 	}
 };
@@ -170,12 +224,12 @@ private:
 template <>
 auto include_reverse_callback<callback::Type::Branchrule>(
 	SCIP* scip,
-	std::weak_ptr<Executor> executor,
+	CallHandler handler,
 	callback::Constructor<callback::Type::Branchrule> args) -> void {
 	scip::call(
 		SCIPincludeObjBranchrule,
 		scip,
-		new ReverseBranchrule(scip, args.priority, args.max_depth, args.max_bound_distance, std::move(executor)),
+		new ReverseBranchrule(scip, args, std::move(handler)),
 		true);
 }  // NOLINT
 
@@ -188,7 +242,7 @@ public:
 		int freqofs,
 		int maxdepth,
 		SCIP_HEURTIMING timingmask,
-		std::weak_ptr<Executor> weak_executor) :
+		CallHandler handler) :
 		ObjHeur{
 			scip,
 			name(callback::Type::Heuristic),
@@ -200,7 +254,7 @@ public:
 			maxdepth,
 			timingmask,
 			false},
-		m_weak_executor{std::move(weak_executor)} {}
+		m_handler{std::move(handler)} {}
 
 	auto scip_exec(
 		SCIP* scip,
@@ -209,19 +263,19 @@ public:
 		SCIP_Bool node_infeasible,
 		SCIP_RESULT* result) -> SCIP_RETCODE override {
 		auto retcode = SCIP_OKAY;
-		std::tie(retcode, *result) = handle_executor(
-			scip, m_weak_executor, callback::HeuristicCall{heuristic_timing, static_cast<bool>(node_infeasible)});
+		std::tie(retcode, *result) = handle_call(
+			scip, m_handler, callback::HeuristicCall{heuristic_timing, static_cast<bool>(node_infeasible)});
 		return retcode;
 	}
 
 private:
-	std::weak_ptr<Executor> m_weak_executor;
+	CallHandler m_handler;
 };
 
 template <>
 auto include_reverse_callback<callback::Type::Heuristic>(
 	SCIP* scip,
-	std::weak_ptr<Executor> executor,
+	CallHandler handler,
 	callback::Constructor<callback::Type::Heuristic> args) -> void {
 	scip::call(
 		SCIPincludeObjHeur,
@@ -233,7 +287,7 @@ auto include_reverse_callback<callback::Type::Heuristic>(
 			args.frequency_offset,
 			args.max_depth,
 			args.timing_mask,
-			std::move(executor)),
+			std::move(handler)),
 		true);
 }  // NOLINT
 
@@ -243,14 +297,14 @@ public:
 		SCIP* scip,
 		int stdpriority, /**< priority of the node selector in standard mode */
 		int memsavepriority,
-		std::weak_ptr<Executor> weak_executor) :
+		CallHandler handler) :
 		ObjNodesel{
 			scip,
 			name(callback::Type::Nodesel),
 			"Nodesel that waits for another thread to pick the next open node.",
 			stdpriority,
 			memsavepriority},
-		m_weak_executor{std::move(weak_executor)} {}
+		m_handler{std::move(handler)} {}
 
 	/** node selection method of node selector
 	 *
@@ -268,7 +322,7 @@ public:
 	auto scip_select(SCIP* scip, SCIP_NODESEL* /* nodesel */, SCIP_NODE** selnode) -> SCIP_RETCODE override {
 		auto retcode = SCIP_OKAY;
 		auto result = SCIP_DIDNOTRUN;
-		std::tie(retcode, result) = handle_executor(scip, m_weak_executor, callback::NodeselCall{selnode});
+		std::tie(retcode, result) = handle_call(scip, m_handler, callback::NodeselCall{selnode});
 		return retcode;
 	}
 
@@ -304,18 +358,18 @@ public:
 	}
 
 private:
-	std::weak_ptr<Executor> m_weak_executor;
+	CallHandler m_handler;
 };
 
 template <>
 auto include_reverse_callback<callback::Type::Nodesel>(
 	SCIP* scip,
-	std::weak_ptr<Executor> executor,
+	CallHandler handler,
 	callback::Constructor<callback::Type::Nodesel> args) -> void {
 	scip::call(
 		SCIPincludeObjNodesel,
 		scip,
-		new ReverseNodesel(scip, args.stdpriority, args.memsavepriority, std::move(executor)),
+		new ReverseNodesel(scip, args.stdpriority, args.memsavepriority, std::move(handler)),
 		true);
 }  // NOLINT
 
@@ -339,17 +393,252 @@ std::unique_ptr<SCIP, ScipDeleter> create_scip() {
 	return scip_ptr;
 }
 
+/**
+ * Summary of an original problem, to detect modifications made without invalidating the snapshots.
+ *
+ * It covers the number of variables and constraints, the objective, and the bounds and types of the variables, but
+ * not the content of the constraints.
+ */
+struct Fingerprint {
+	int n_vars = 0;
+	int n_conss = 0;
+	SCIP_OBJSENSE obj_sense = SCIP_OBJSENSE_MINIMIZE;
+	std::uint64_t hash = 0;
+
+	[[nodiscard]] auto operator==(Fingerprint const& other) const noexcept -> bool {
+		return std::tie(n_vars, n_conss, obj_sense, hash) ==
+		       std::tie(other.n_vars, other.n_conss, other.obj_sense, other.hash);
+	}
+};
+
+/**
+ * Fingerprint of the original problem of a SCIP in problem stage.
+ *
+ * Only reads data that copies do not write, so that it can be computed while the SCIP is being copied.
+ */
+auto fingerprint(SCIP* scip) noexcept -> Fingerprint {
+	// Word wise FNV-1a hash
+	auto hash = std::uint64_t{14695981039346656037ULL};
+	auto const combine = [&hash](auto val) {
+		auto word = std::uint64_t{0};
+		static_assert(sizeof(val) <= sizeof(word));
+		std::memcpy(&word, &val, sizeof(val));
+		hash = (hash ^ word) * 1099511628211ULL;
+	};
+	combine(SCIPgetOrigObjoffset(scip));
+	auto* const* const vars = SCIPgetOrigVars(scip);
+	auto const n_vars = SCIPgetNOrigVars(scip);
+	for (int i = 0; i < n_vars; ++i) {
+		combine(SCIPvarGetObj(vars[i]));
+		combine(SCIPvarGetLbOriginal(vars[i]));
+		combine(SCIPvarGetUbOriginal(vars[i]));
+		combine(SCIPvarGetType(vars[i]));
+	}
+	return {n_vars, SCIPgetNOrigConss(scip), SCIPgetObjsense(scip), hash};
+}
+
 }  // namespace
 
-Scimpl::Scimpl() : m_scip{create_scip()} {}
+/**
+ * Private copies of a problem, used as sources for concurrent copies.
+ *
+ * SCIPcopy and SCIPcopyOrig write into their source, so two copies of the same SCIP cannot run at the same time.
+ * Rather than having all threads wait on one another, a thread finding the source busy makes a snapshot of it, that
+ * is a copy that is never modified, and copies from the snapshot.
+ * Snapshots are kept in a fixed number of lock-free slots so that, once every thread has a snapshot available, copies
+ * of a model that is not modified run concurrently without taking any lock.
+ * There are never more snapshots alive than slots, copies waiting for the source once that limit is reached.
+ *
+ * Snapshots are only used when the source is busy, so copies made without contention are the same as without a pool.
+ *
+ * Snapshots are tagged with the generation of the source they were made from.
+ * Invalidating them only increments the generation, outdated snapshots being freed lazily when they are found, so
+ * that it is cheap and safe to do concurrently with copies.
+ * Since the source may also be modified through a SCIP pointer obtained earlier, snapshots also keep the fingerprint
+ * of the source, taken while holding the source mutex, and are outdated when the source fingerprint differs.
+ */
+class SnapshotPool {
+public:
+	using Generation = std::uint64_t;
+
+	/** A snapshot of the source, that gives back its place in the pool when destroyed. */
+	class Snapshot {
+	public:
+		Snapshot(Generation generation, std::atomic<std::size_t>& n_snapshots) :
+			m_scip{create_scip()}, m_generation{generation}, m_n_snapshots{n_snapshots} {}
+		Snapshot(Snapshot const&) = delete;
+		Snapshot& operator=(Snapshot const&) = delete;
+		~Snapshot() { m_n_snapshots.fetch_sub(1, std::memory_order_relaxed); }
+
+		[[nodiscard]] auto scip() const noexcept -> SCIP* { return m_scip.get(); }
+		[[nodiscard]] auto generation() const noexcept -> Generation { return m_generation; }
+		[[nodiscard]] auto fingerprint() const noexcept -> Fingerprint const& { return m_fingerprint; }
+
+		/** Copy the source in the snapshot, must be called while holding the source mutex. */
+		auto fill(SCIP* source) -> void {
+			scip::call(SCIPcopyOrig, source, m_scip.get(), nullptr, nullptr, "", false, true, false, nullptr);
+			m_fingerprint = scip::fingerprint(source);
+		}
+
+	private:
+		std::unique_ptr<SCIP, ScipDeleter> m_scip;
+		Generation m_generation;
+		Fingerprint m_fingerprint;
+		std::atomic<std::size_t>& m_n_snapshots;
+	};
+
+	SnapshotPool() : m_slots(std::max(std::thread::hardware_concurrency(), 1U)) {
+		for (auto& slot : m_slots) {
+			slot.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	SnapshotPool(SnapshotPool const&) = delete;
+	SnapshotPool& operator=(SnapshotPool const&) = delete;
+
+	~SnapshotPool() {
+		for (auto& slot : m_slots) {
+			delete slot.exchange(nullptr, std::memory_order_relaxed);  // NOLINT(cppcoreguidelines-owning-memory)
+		}
+	}
+
+	/** Make all existing snapshots outdated, can be called concurrently with other methods. */
+	auto invalidate() noexcept -> void { m_generation.fetch_add(1, std::memory_order_acq_rel); }
+
+	/**
+	 * Take exclusive ownership of an available up to date snapshot, or return null if there is none.
+	 *
+	 * Snapshots with another fingerprint than the given one, that of the source, are outdated.
+	 */
+	auto acquire(Fingerprint const& source_fingerprint) noexcept -> std::unique_ptr<Snapshot> {
+		for (auto& slot : m_slots) {
+			if (slot.load(std::memory_order_relaxed) != nullptr) {
+				auto snapshot = std::unique_ptr<Snapshot>{slot.exchange(nullptr, std::memory_order_acquire)};
+				if ((snapshot != nullptr) && (snapshot->generation() == generation()) &&
+				    (snapshot->fingerprint() == source_fingerprint)) {
+					return snapshot;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Create an empty snapshot of the current generation, to be filled with a copy of the source.
+	 *
+	 * Return null if there are already as many snapshots alive as slots.
+	 */
+	auto create() -> std::unique_ptr<Snapshot> {
+		if (m_n_snapshots.fetch_add(1, std::memory_order_relaxed) >= m_slots.size()) {
+			m_n_snapshots.fetch_sub(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		auto const generation = this->generation();
+		try {
+			return std::make_unique<Snapshot>(generation, m_n_snapshots);
+		} catch (...) {
+			m_n_snapshots.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+
+	/** Give back a snapshot for other copies to use, it is freed if it is outdated or all slots are taken. */
+	auto release(std::unique_ptr<Snapshot>&& snapshot) noexcept -> void {
+		if (snapshot->generation() != generation()) {
+			return;
+		}
+		for (auto& slot : m_slots) {
+			Snapshot* expected = nullptr;
+			if (slot.compare_exchange_strong(expected, snapshot.get(), std::memory_order_release)) {
+				snapshot.release();
+				return;
+			}
+		}
+	}
+
+	/** Mutex guarding direct copies from the source SCIP. */
+	auto source_mutex() noexcept -> std::mutex& { return m_source_mutex; }
+
+private:
+	std::vector<std::atomic<Snapshot*>> m_slots;
+	std::atomic<Generation> m_generation = 0;
+	std::atomic<std::size_t> m_n_snapshots = 0;
+	std::mutex m_source_mutex;
+
+	[[nodiscard]] auto generation() const noexcept -> Generation {
+		return m_generation.load(std::memory_order_acquire);
+	}
+};
+
+namespace {
+
+/**
+ * Copy a SCIP with the given copy function, concurrently with other copies of the same source when possible.
+ *
+ * The copy function is called with the source and destination SCIP, and whether the copy must not share data with its
+ * source.
+ */
+template <typename CopyFunc>
+auto concurrent_copy(SCIP* source, SnapshotPool& snapshots, CopyFunc const& copy_func)
+	-> std::unique_ptr<SCIP, ScipDeleter> {
+	auto dest = create_scip();
+	// Outside of the problem stage, the source may change without its snapshots being invalidated.
+	if (SCIPgetStage(source) != SCIP_STAGE_PROBLEM) {
+		auto const lock = std::lock_guard{snapshots.source_mutex()};
+		copy_func(source, dest.get(), false);
+		return dest;
+	}
+	{
+		auto const lock = std::unique_lock{snapshots.source_mutex(), std::try_to_lock};
+		if (lock.owns_lock()) {
+			// Without contention, the copy is made from the source as if there were no snapshots.
+			copy_func(source, dest.get(), false);
+			return dest;
+		}
+	}
+	// Source is being copied by another thread, copy from a snapshot instead.
+	auto snapshot = snapshots.acquire(fingerprint(source));
+	if (snapshot == nullptr) {
+		// Make a snapshot that this and future copies can use.
+		snapshot = snapshots.create();
+		auto const lock = std::lock_guard{snapshots.source_mutex()};
+		if (snapshot == nullptr) {
+			// There are already as many snapshots as allowed.
+			copy_func(source, dest.get(), false);
+			return dest;
+		}
+		snapshot->fill(source);
+	}
+	copy_func(snapshot->scip(), dest.get(), true);
+	snapshots.release(std::move(snapshot));
+	return dest;
+}
+
+}  // namespace
+
+Scimpl::Scimpl() :
+	m_scip{create_scip()},
+	m_snapshots{std::make_unique<SnapshotPool>()},
+	m_coroutine_backend{utility::default_coroutine_backend} {}
 
 Scimpl::Scimpl(Scimpl&&) noexcept = default;
 
-Scimpl::Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& scip_ptr) noexcept : m_scip(std::move(scip_ptr)) {}
+Scimpl::Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& scip_ptr) :
+	m_scip(std::move(scip_ptr)),
+	m_snapshots{std::make_unique<SnapshotPool>()},
+	m_coroutine_backend{utility::default_coroutine_backend} {}
 
 Scimpl::~Scimpl() = default;
 
 auto Scimpl::get_scip_ptr() noexcept -> SCIP* {
+	// The problem may be modified through the pointer so snapshots of it are no longer valid.
+	if (m_snapshots != nullptr) {
+		m_snapshots->invalidate();
+	}
+	return m_scip.get();
+}
+
+auto Scimpl::get_scip_ptr() const noexcept -> SCIP const* {
 	return m_scip.get();
 }
 
@@ -360,12 +649,9 @@ auto Scimpl::copy() const -> Scimpl {
 	if (SCIPgetStage(m_scip.get()) == SCIP_STAGE_INIT) {
 		return {create_scip()};
 	}
-	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", true, false, false, false, nullptr);
-	return {std::move(dest)};
+	return concurrent_copy(m_scip.get(), *m_snapshots, [](SCIP* source, SCIP* dest, bool threadsafe) {
+		scip::call(SCIPcopy, source, dest, nullptr, nullptr, "", true, false, threadsafe, false, nullptr);
+	});
 }
 
 auto Scimpl::copy_orig() const -> Scimpl {
@@ -375,20 +661,25 @@ auto Scimpl::copy_orig() const -> Scimpl {
 	if (SCIPgetStage(m_scip.get()) == SCIP_STAGE_INIT) {
 		return {create_scip()};
 	}
-	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopyOrig, m_scip.get(), dest.get(), nullptr, nullptr, "", false, false, false, nullptr);
-	return {std::move(dest)};
+	return concurrent_copy(m_scip.get(), *m_snapshots, [](SCIP* source, SCIP* dest, bool threadsafe) {
+		scip::call(SCIPcopyOrig, source, dest, nullptr, nullptr, "", false, threadsafe, false, nullptr);
+	});
+}
+
+auto Scimpl::coroutine_backend() const noexcept -> utility::CoroutineBackend {
+	return m_coroutine_backend;
+}
+
+auto Scimpl::set_coroutine_backend(utility::CoroutineBackend backend) noexcept -> void {
+	m_coroutine_backend = backend;
 }
 
 auto Scimpl::solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 	-> std::optional<callback::DynamicCall> {
 	auto* const scip_ptr = get_scip_ptr();
-	m_controller = std::make_unique<Controller>([=](std::weak_ptr<Executor> const& executor) {
+	m_controller = std::make_unique<Controller>(m_coroutine_backend, [=](std::weak_ptr<Executor> const& executor) {
 		for (auto const pack : arg_packs) {
-			std::visit([&](auto args) { include_reverse_callback(scip_ptr, executor, args); }, pack);
+			std::visit([&](auto args) { include_reverse_callback(scip_ptr, {executor, {}}, args); }, pack);
 		}
 		scip::call(SCIPsolve, scip_ptr);
 	});
@@ -400,4 +691,30 @@ auto Scimpl::solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::
 	return m_controller->wait();
 }
 
+auto Scimpl::solve_direct(nonstd::span<callback::DynamicConstructor const> arg_packs, callback::DirectHandler handler)
+	-> void {
+	auto* const scip_ptr = get_scip_ptr();
+	// Exceptions cannot cross SCIP, they are saved and rethrown once SCIP has stopped.
+	auto handler_exception = std::make_shared<std::exception_ptr>();
+	auto direct = [handler = std::move(handler), handler_exception](callback::DynamicCall call) -> SCIP_RESULT {
+		try {
+			return handler(call);
+		} catch (...) {
+			*handler_exception = std::current_exception();
+			throw;
+		}
+	};
+	for (auto const pack : arg_packs) {
+		std::visit([&](auto args) { include_reverse_callback(scip_ptr, {{}, direct}, args); }, pack);
+	}
+	try {
+		scip::call(SCIPsolve, scip_ptr);
+	} catch (...) {
+		if (*handler_exception) {
+			std::rethrow_exception(*handler_exception);
+		}
+		throw;
+	}
+}
+
 }  // namespace ecole::scip
@@ -0,0 +1,46 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ecole/utility/coroutine.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+auto spin_budget = std::atomic<std::size_t>{0};
+auto n_spin_hits = std::atomic<std::uint64_t>{0};
+auto n_parks = std::atomic<std::uint64_t>{0};
+
+}  // namespace
+
+auto coroutine_spin_budget() noexcept -> std::size_t {
+	return spin_budget.load(std::memory_order_relaxed);
+}
+
+auto set_coroutine_spin_budget(std::size_t budget) noexcept -> void {
+	spin_budget.store(budget, std::memory_order_relaxed);
+}
+
+auto coroutine_handoff_stats() noexcept -> CoroutineHandoffStats {
+	return {n_spin_hits.load(std::memory_order_relaxed), n_parks.load(std::memory_order_relaxed)};
+}
+
+auto reset_coroutine_handoff_stats() noexcept -> void {
+	n_spin_hits.store(0, std::memory_order_relaxed);
+	n_parks.store(0, std::memory_order_relaxed);
+}
+
+namespace internal {
+
+auto record_coroutine_handoff(bool parked) noexcept -> void {
+	if (parked) {
+		n_parks.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		n_spin_hits.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+}  // namespace internal
+
+}  // namespace ecole::utility
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "utility/csr-graph.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+/** Counting sort of the values by keys, filling the indptr and indices of a compressed sparse row structure. */
+void compress(
+	std::size_t n_keys,
+	nonstd::span<std::size_t const> keys,
+	nonstd::span<std::size_t const> values,
+	std::vector<std::size_t>& indptr,
+	std::vector<std::size_t>& indices) {
+	assert(keys.size() == values.size());
+	indptr.assign(n_keys + 1, 0);
+	for (auto const key : keys) {
+		assert(key < n_keys);
+		indptr[key + 1]++;
+	}
+	std::partial_sum(indptr.begin(), indptr.end(), indptr.begin());
+
+	indices.resize(keys.size());
+	auto position = std::vector<std::size_t>(indptr.begin(), indptr.end() - 1);
+	for (std::size_t i = 0; i < keys.size(); ++i) {
+		indices[position[keys[i]]++] = values[i];
+	}
+}
+
+}  // namespace
+
+/**************************************
+ *  Implementation of GroupIncidence  *
+ *************************************/
+
+GroupIncidence::GroupIncidence(
+	std::size_t n_nodes,
+	std::size_t n_groups,
+	nonstd::span<Group const> group_of,
+	nonstd::span<Node const> node_of) {
+	compress(n_groups, group_of, node_of, group_indptr, group_indices);
+
+	// Visiting groups in order sorts the groups of each node.
+	auto groups_in_order = std::vector<Group>(group_indices.size());
+	for (Group group = 0; group < n_groups; ++group) {
+		std::fill(
+			groups_in_order.begin() + static_cast<std::ptrdiff_t>(group_indptr[group]),
+			groups_in_order.begin() + static_cast<std::ptrdiff_t>(group_indptr[group + 1]),
+			group);
+	}
+	compress(n_nodes, group_indices, groups_in_order, node_indptr, node_indices);
+}
+
+auto GroupIncidence::group_nodes(Group group) const noexcept -> nonstd::span<Node const> {
+	return {group_indices.data() + group_indptr[group], group_indptr[group + 1] - group_indptr[group]};
+}
+
+auto GroupIncidence::node_groups(Node node) const noexcept -> nonstd::span<Group const> {
+	return {node_indices.data() + node_indptr[node], node_indptr[node + 1] - node_indptr[node]};
+}
+
+auto GroupIncidence::expansion_work() const noexcept -> std::size_t {
+	auto work = std::size_t{0};
+	for (Group group = 0; group < n_groups(); ++group) {
+		auto const size = group_nodes(group).size();
+		work += size * (size - 1);
+	}
+	return work;
+}
+
+auto GroupIncidence::expansion_degree(Node node, std::vector<Node>& marker) const -> std::size_t {
+	auto degree = std::size_t{0};
+	expansion_visit(node, marker, [&degree](auto /* neighbor */) { ++degree; });
+	return degree;
+}
+
+void GroupIncidence::expansion_neighbors(Node node, std::vector<Node>& marker, std::vector<Node>& out) const {
+	out.clear();
+	expansion_visit(node, marker, [&out](auto neighbor) { out.push_back(neighbor); });
+}
+
+auto GroupIncidence::share_group(Node node1, Node node2) const noexcept -> bool {
+	auto const groups1 = node_groups(node1);
+	auto const groups2 = node_groups(node2);
+	auto iter1 = groups1.begin();
+	auto iter2 = groups2.begin();
+	while ((iter1 != groups1.end()) && (iter2 != groups2.end())) {
+		if (*iter1 == *iter2) {
+			return true;
+		}
+		if (*iter1 < *iter2) {
+			++iter1;
+		} else {
+			++iter2;
+		}
+	}
+	return false;
+}
+
+/********************************
+ *  Implementation of CsrGraph  *
+ *******************************/
+
+auto CsrGraph::clique_expansion(GroupIncidence const& incidence) -> CsrGraph {
+	auto const n_nodes = incidence.n_nodes();
+	auto graph = CsrGraph{n_nodes};
+
+	// First pass counts the neighbours of each node.
+	auto marker = std::vector<Node>(n_nodes, n_nodes);
+	for (Node node = 0; node < n_nodes; ++node) {
+		graph.indptr[node + 1] = graph.indptr[node] + incidence.expansion_degree(node, marker);
+	}
+
+	// Second pass writes the neighbours, in the order in which they are found.
+	auto unsorted = std::vector<Node>(graph.indptr.back());
+	std::fill(marker.begin(), marker.end(), n_nodes);
+	auto out = unsorted.begin();
+	for (Node node = 0; node < n_nodes; ++node) {
+		incidence.expansion_visit(node, marker, [&out](auto neighbor) { *(out++) = neighbor; });
+	}
+	assert(out == unsorted.end());
+
+	// The graph is symmetric so transposing it with a counting sort yields the same graph with sorted neighbours.
+	graph.indices.resize(unsorted.size());
+	auto position = std::vector<std::size_t>(graph.indptr.begin(), graph.indptr.end() - 1);
+	for (Node node = 0; node < n_nodes; ++node) {
+		for (auto i = graph.indptr[node]; i < graph.indptr[node + 1]; ++i) {
+			graph.indices[position[unsorted[i]]++] = node;
+		}
+	}
+	return graph;
+}
+
+auto CsrGraph::neighbors(Node n) const noexcept -> nonstd::span<Node const> {
+	return {indices.data() + indptr[n], degree(n)};
+}
+
+auto CsrGraph::are_connected(Node n1, Node n2) const noexcept -> bool {
+	// Search in the smallest neighbourhood.
+	if (degree(n1) > degree(n2)) {
+		std::swap(n1, n2);
+	}
+	auto const n1_neighbors = neighbors(n1);
+	return std::binary_search(n1_neighbors.begin(), n1_neighbors.end(), n2);
+}
+
+auto CsrGraph::triangle_counts() const -> std::vector<std::size_t> {
+	auto const n_nodes_ = n_nodes();
+
+	// Keep only the forward neighbours of each node.
+	auto forward_indptr = std::vector<std::size_t>(n_nodes_ + 1, 0);
+	auto forward_indices = std::vector<Node>{};
+	forward_indices.reserve(n_edges());
+	for (Node node = 0; node < n_nodes_; ++node) {
+		for (auto const neighbor : neighbors(node)) {
+			if (is_forward(node, neighbor)) {
+				forward_indices.push_back(neighbor);
+			}
+		}
+		forward_indptr[node + 1] = forward_indices.size();
+	}
+	auto forward = [&](Node node) {
+		return nonstd::span<Node const>{
+			forward_indices.data() + forward_indptr[node], forward_indptr[node + 1] - forward_indptr[node]};
+	};
+
+	// Each triangle is found from its lowest node, by closing a forward path with a marked forward neighbour.
+	auto triangles = std::vector<std::size_t>(n_nodes_, 0);
+	auto marker = std::vector<Node>(n_nodes_, n_nodes_);
+	for (Node node = 0; node < n_nodes_; ++node) {
+		for (auto const neighbor : forward(node)) {
+			marker[neighbor] = node;
+		}
+		for (auto const neighbor : forward(node)) {
+			for (auto const third : forward(neighbor)) {
+				if (marker[third] == node) {
+					++triangles[node];
+					++triangles[neighbor];
+					++triangles[third];
+				}
+			}
+		}
+	}
+	return triangles;
+}
+
+auto CsrGraph::triangle_work() const -> std::size_t {
+	auto const n_nodes_ = n_nodes();
+	auto forward_degrees = std::vector<std::size_t>(n_nodes_, 0);
+	for (Node node = 0; node < n_nodes_; ++node) {
+		for (auto const neighbor : neighbors(node)) {
+			forward_degrees[node] += is_forward(node, neighbor) ? 1 : 0;
+		}
+	}
+	auto work = std::size_t{0};
+	for (Node node = 0; node < n_nodes_; ++node) {
+		for (auto const neighbor : neighbors(node)) {
+			if (is_forward(node, neighbor)) {
+				work += forward_degrees[neighbor];
+			}
+		}
+	}
+	return work;
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/**
+ * Membership of nodes into groups, stored in compressed sparse row format in both directions.
+ *
+ * For instance, the groups can be the constraints of a problem and the nodes its variables.
+ * The clique expansion of the groups is the graph where two nodes are connected if they share a group.
+ */
+class ECOLE_EXPORT GroupIncidence {
+public:
+	using Node = std::size_t;
+	using Group = std::size_t;
+
+	/**
+	 * Group memberships given as pairs (group_of[i], node_of[i]), in any order.
+	 *
+	 * Runs in time linear in the number of memberships, nodes, and groups.
+	 * The groups of each node are sorted.
+	 */
+	ECOLE_EXPORT GroupIncidence(
+		std::size_t n_nodes,
+		std::size_t n_groups,
+		nonstd::span<Group const> group_of,
+		nonstd::span<Node const> node_of);
+
+	[[nodiscard]] auto n_nodes() const noexcept -> std::size_t { return node_indptr.size() - 1; }
+	[[nodiscard]] auto n_groups() const noexcept -> std::size_t { return group_indptr.size() - 1; }
+	[[nodiscard]] ECOLE_EXPORT auto group_nodes(Group group) const noexcept -> nonstd::span<Node const>;
+	[[nodiscard]] ECOLE_EXPORT auto node_groups(Node node) const noexcept -> nonstd::span<Group const>;
+
+	/** Upper bound on the work (and the number of directed edges) of the clique expansion. */
+	[[nodiscard]] ECOLE_EXPORT auto expansion_work() const noexcept -> std::size_t;
+
+	/**
+	 * Number of distinct neighbours of a node in the clique expansion.
+	 *
+	 * The marker must have one element per node, initialized to a value that is not a node (such as n_nodes()).
+	 * It can be reused across calls with distinct nodes without being reset.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto expansion_degree(Node node, std::vector<Node>& marker) const -> std::size_t;
+
+	/** Distinct neighbours of a node in the clique expansion, written in out, with the same marker as above. */
+	ECOLE_EXPORT void expansion_neighbors(Node node, std::vector<Node>& marker, std::vector<Node>& out) const;
+
+	/** Whether two nodes are connected in the clique expansion, by merging their sorted groups. */
+	[[nodiscard]] ECOLE_EXPORT auto share_group(Node node1, Node node2) const noexcept -> bool;
+
+	/** Call a function on every distinct neighbour of a node in the clique expansion, with the same marker as above. */
+	template <typename Func> void expansion_visit(Node node, std::vector<Node>& marker, Func&& func) const;
+
+private:
+	std::vector<std::size_t> group_indptr;
+	std::vector<Node> group_indices;
+	std::vector<std::size_t> node_indptr;
+	std::vector<Group> node_indices;
+};
+
+/**
+ * An immutable symmetric graph stored in compressed sparse row format.
+ *
+ * The neighbours of each node are stored contiguously, sorted, and without self loops.
+ */
+class ECOLE_EXPORT CsrGraph {
+public:
+	using Node = std::size_t;
+
+	/**
+	 * Build the clique expansion of the groups.
+	 *
+	 * Runs in time linear in GroupIncidence::expansion_work, using a dense marker array rather than hashing to
+	 * deduplicate neighbours.
+	 */
+	ECOLE_EXPORT static auto clique_expansion(GroupIncidence const& incidence) -> CsrGraph;
+
+	/** Empty graph with only nodes. */
+	CsrGraph(std::size_t n_nodes = 0) : indptr(n_nodes + 1, 0) {}
+
+	[[nodiscard]] auto n_nodes() const noexcept -> std::size_t { return indptr.size() - 1; }
+	[[nodiscard]] auto n_edges() const noexcept -> std::size_t { return indices.size() / 2; }
+	[[nodiscard]] auto degree(Node n) const noexcept -> std::size_t { return indptr[n + 1] - indptr[n]; }
+	[[nodiscard]] ECOLE_EXPORT auto neighbors(Node n) const noexcept -> nonstd::span<Node const>;
+	[[nodiscard]] ECOLE_EXPORT auto are_connected(Node n1, Node n2) const noexcept -> bool;
+
+	/**
+	 * Number of triangles that each node belongs to.
+	 *
+	 * Uses the forward algorithm, where edges are oriented from lower to higher degree nodes, and each triangle is
+	 * found once from its lowest node.
+	 * Runs in O(n_edges^1.5) time, and exactly in triangle_work() steps.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto triangle_counts() const -> std::vector<std::size_t>;
+
+	/** Number of steps of triangle_counts, computed in time linear in the number of edges. */
+	[[nodiscard]] ECOLE_EXPORT auto triangle_work() const -> std::size_t;
+
+private:
+	std::vector<std::size_t> indptr;
+	std::vector<Node> indices;
+
+	/** Whether n2 comes after n1 when ordering nodes by degree (ties broken by index). */
+	[[nodiscard]] auto is_forward(Node n1, Node n2) const noexcept -> bool {
+		return (degree(n1) < degree(n2)) || ((degree(n1) == degree(n2)) && (n1 < n2));
+	}
+};
+
+/**************************************
+ *  Implementation of GroupIncidence  *
+ *************************************/
+
+template <typename Func> void GroupIncidence::expansion_visit(Node node, std::vector<Node>& marker, Func&& func) const {
+	assert(marker.size() == n_nodes());
+	// Marking the node itself excludes self loops.
+	marker[node] = node;
+	for (auto const group : node_groups(node)) {
+		for (auto const neighbor : group_nodes(group)) {
+			if (marker[neighbor] != node) {
+				marker[neighbor] = node;
+				func(neighbor);
+			}
+		}
+	}
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+
+#include <lpi/lpi.h>
+
+namespace ecole::utility {
+
+/**
+ * Free an LP solver interface, as a unique_ptr deleter.
+ *
+ * Deleters run from destructors, so a failure to free is ignored rather than thrown.
+ */
+struct LpiDeleter {
+	void operator()(SCIP_LPI* lpi) const noexcept { [[maybe_unused]] auto const retcode = SCIPlpiFree(&lpi); }
+};
+
+/** An LP solver interface owned independently of any SCIP model. */
+using unique_lpi = std::unique_ptr<SCIP_LPI, LpiDeleter>;
+
+}  // namespace ecole::utility
@@ -0,0 +1,84 @@
+#include <exception>
+#include <utility>
+
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::utility {
+
+auto ThreadPool::global() -> ThreadPool& {
+	// Leaked on purpose: coroutines may still be alive during static destruction.
+	static auto* const pool = new ThreadPool{};  // NOLINT(cppcoreguidelines-owning-memory)
+	return *pool;
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		auto const lk = std::lock_guard{m_mutex};
+		m_stopping = true;
+	}
+	m_task_available.notify_all();
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+}
+
+auto ThreadPool::submit(std::function<void()> task) -> std::future<void> {
+	auto promise = std::promise<void>{};
+	auto future = promise.get_future();
+	{
+		auto const lk = std::lock_guard{m_mutex};
+		m_tasks.push_back({std::move(task), std::move(promise)});
+		// Tasks can block for a long time, so the pool grows rather than making them wait.
+		if (m_n_idle < m_tasks.size()) {
+			++m_n_idle;
+			m_threads.emplace_back([this] { worker_loop(); });
+		}
+	}
+	m_task_available.notify_one();
+	return future;
+}
+
+auto ThreadPool::n_threads() const -> std::size_t {
+	auto const lk = std::lock_guard{m_mutex};
+	return m_threads.size();
+}
+
+auto ThreadPool::n_idle_threads() const -> std::size_t {
+	auto const lk = std::lock_guard{m_mutex};
+	return m_n_idle;
+}
+
+auto ThreadPool::worker_loop() -> void {
+	// Threads are counted as idle from their creation in submit.
+	auto lk = std::unique_lock{m_mutex};
+	while (true) {
+		m_task_available.wait(lk, [this] { return m_stopping || !m_tasks.empty(); });
+		if (m_tasks.empty()) {
+			return;
+		}
+		--m_n_idle;
+		auto [task, promise] = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		lk.unlock();
+
+		auto error = std::exception_ptr{};
+		try {
+			task();
+		} catch (...) {
+			error = std::current_exception();
+		}
+		// Unlike a packaged_task, the task (and what it captures) is destroyed before the future is made ready.
+		task = nullptr;
+
+		lk.lock();
+		// Back to idle before notifying so that a task submitted right after can reuse this thread.
+		++m_n_idle;
+		if (error) {
+			promise.set_exception(error);
+		} else {
+			promise.set_value();
+		}
+	}
+}
+
+}  // namespace ecole::utility
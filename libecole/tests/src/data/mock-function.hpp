@@ -14,7 +14,15 @@ template <typename T> struct MockFunction {
 	[[nodiscard]] auto extract(scip::Model const& /* model */, bool /* done */) const -> T { return val; }
 };
 
+/** Dummy data function declaring that it only reads the model. */
+template <typename T> struct ReadOnlyMockFunction : MockFunction<T> {
+	static inline constexpr bool read_only = true;
+
+	using MockFunction<T>::MockFunction;
+};
+
 using IntDataFunc = MockFunction<int>;
 using DoubleDataFunc = MockFunction<double>;
+using ReadOnlyIntDataFunc = ReadOnlyMockFunction<int>;
 
 }  // namespace ecole::data
@@ -0,0 +1,71 @@
+#include <type_traits>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/data/lazy.hpp"
+#include "ecole/exception.hpp"
+
+#include "conftest.hpp"
+#include "data/mock-function.hpp"
+#include "data/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Data LazyFunction unit tests", "[unit][data]") {
+	data::unit_tests(data::LazyFunction<data::IntDataFunc>{});
+}
+
+TEST_CASE("Lazy data function extracts on access", "[data]") {
+	auto lazy_func = data::LazyFunction<data::IntDataFunc>{{1}};
+	auto model = get_model();
+
+	lazy_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	REQUIRE(lazy_func.extract(model, false).extracted());
+	lazy_func.before_transition(model);
+	auto data = lazy_func.extract(model, false);
+	STATIC_REQUIRE(std::is_same_v<decltype(data), data::Lazy<int>>);
+	REQUIRE_FALSE(data.extracted());
+
+	SECTION("Data is extracted once") {
+		REQUIRE(data.get() == 2);
+		REQUIRE(data.extracted());
+		lazy_func.before_transition(model);
+		REQUIRE(data.get() == 2);
+	}
+
+	SECTION("Data expires on transition") {
+		lazy_func.before_transition(model);
+		REQUIRE(data.expired());
+		REQUIRE_THROWS_AS(data.get(), MarkovError);
+	}
+
+	SECTION("Data expires on reset") {
+		lazy_func.before_reset(model);
+		REQUIRE(data.expired());
+	}
+}
+
+TEST_CASE("Lazy data function extracts eagerly after reset", "[data]") {
+	auto lazy_func = data::LazyFunction<data::IntDataFunc>{{1}};
+	auto model = get_model();
+
+	for (auto n_resets = 0; n_resets < 2; ++n_resets) {
+		lazy_func.before_reset(model);
+		// The root extraction happens even if the handle is never accessed
+		auto const root_data = lazy_func.extract(model, false);
+		REQUIRE(root_data.extracted());
+		lazy_func.before_transition(model);
+		REQUIRE_FALSE(lazy_func.extract(model, false).extracted());
+	}
+}
+
+TEST_CASE("Copy a moved-from lazy data function", "[data]") {
+	auto lazy_func = data::LazyFunction<data::IntDataFunc>{{1}};
+	[[maybe_unused]] auto const moved = std::move(lazy_func);
+	// NOLINTNEXTLINE(bugprone-use-after-move)
+	auto const copy = lazy_func;
+	auto other = data::LazyFunction<data::IntDataFunc>{};
+	other = lazy_func;
+}
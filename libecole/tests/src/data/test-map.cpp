@@ -1,3 +1,4 @@
+#include <map>
 #include <string>
 #include <type_traits>
 
@@ -26,3 +27,14 @@ TEST_CASE("Combine data extraction functions into a map", "[data]") {
 	REQUIRE(data.at("a") == 2);
 	REQUIRE(data.at("b") == 3);
 }
+
+TEST_CASE("Read-only data functions are combined concurrently into a map", "[data]") {
+	auto data_func = MapFunction<std::string, ReadOnlyIntDataFunc>{{{"a", {1}}, {"b", {2}}, {"c", {3}}}};
+	STATIC_REQUIRE(decltype(data_func)::read_only);
+	auto model = get_model();
+
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const data = data_func.extract(model, false);
+	REQUIRE(data == std::map<std::string, int>{{"a", 2}, {"b", 3}, {"c", 4}});
+}
@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/data/step-context.hpp"
+#include "ecole/data/tuple.hpp"
+#include "ecole/data/vector.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/traits.hpp"
+
+#include "conftest.hpp"
+#include "data/mock-function.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Dummy data function recording the contexts it is extracted in. */
+struct ContextMockFunction {
+	std::shared_ptr<std::vector<data::StepContext const*>> contexts =
+		std::make_shared<std::vector<data::StepContext const*>>();
+
+	auto before_reset(scip::Model& /* model */) -> void {}
+
+	auto extract(scip::Model& model, bool done) -> int {
+		auto context = data::StepContext{};
+		return extract_in_context(model, done, context);
+	}
+
+	auto extract_in_context(scip::Model& /* model */, bool /* done */, data::StepContext& context) -> int {
+		contexts->push_back(&context);
+		return 0;
+	}
+};
+
+}  // namespace
+
+TEST_CASE("Detect data functions taking a context", "[data]") {
+	STATIC_REQUIRE(trait::internal::has_extract_in_context_v<ContextMockFunction>);
+	STATIC_REQUIRE_FALSE(trait::internal::has_extract_in_context_v<data::IntDataFunc>);
+	STATIC_REQUIRE(trait::internal::has_extract_in_context_v<data::TupleFunction<data::IntDataFunc>>);
+}
+
+TEST_CASE("Step context memoizes quantities until invalidated", "[data]") {
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto context = data::StepContext{};
+
+	auto const& cands = context.lp_branch_cands(model);
+	REQUIRE(&context.lp_branch_cands(model) == &cands);
+	auto const lp_cands = model.lp_branch_cands();
+	REQUIRE(cands.variables == std::vector<SCIP_VAR*>(lp_cands.begin(), lp_cands.end()));
+	REQUIRE(cands.lp_values.size() == lp_cands.size());
+	for (std::size_t i = 0; i < lp_cands.size(); ++i) {
+		REQUIRE(cands.indices[i] == static_cast<std::size_t>(SCIPvarGetProbindex(lp_cands[i])));
+	}
+
+	REQUIRE(context.pseudo_branch_cands(model).variables.size() == model.pseudo_branch_cands().size());
+	REQUIRE(context.lp_row_norms(model).size() == model.lp_rows().size());
+	REQUIRE(context.n_lps(model) == SCIPgetNLPs(model.get_scip_ptr()));
+
+	context.invalidate();
+	REQUIRE(context.lp_branch_cands(model).variables.size() == lp_cands.size());
+}
+
+TEST_CASE("Concurrent reads are only reported safe with the LP of the current node solved", "[data]") {
+	auto model = get_model();
+	auto context = data::StepContext{};
+	REQUIRE_FALSE(context.prepare_concurrent_reads(model));
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto* const scip = model.get_scip_ptr();
+	auto const lp_solved = SCIPhasCurrentNodeLP(scip) && (SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL);
+	REQUIRE(context.prepare_concurrent_reads(model) == lp_solved);
+}
+
+TEST_CASE("Combined data functions share the same context", "[data]") {
+	auto func = ContextMockFunction{};
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	SECTION("With a new context") {
+		auto data_func = data::TupleFunction{func, data::IntDataFunc{}, func};
+		data_func.extract(model, false);
+		REQUIRE(func.contexts->size() == 2);
+		REQUIRE(func.contexts->front() == func.contexts->back());
+	}
+
+	SECTION("With a given context") {
+		auto data_func = data::VectorFunction{std::vector{func, func}};
+		auto context = data::StepContext{};
+		data_func.extract_in_context(model, false, context);
+		REQUIRE(*func.contexts == std::vector<data::StepContext const*>{&context, &context});
+	}
+}
+
+TEST_CASE("Read-only observation functions extracted concurrently match a sequential extraction", "[data]") {
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const same = [](auto const& tensor, auto const& expected) {
+		return (tensor.shape() == expected.shape()) && xt::all(xt::isclose(tensor, expected, 0., 0., true));
+	};
+
+	auto data_func = data::TupleFunction{
+		observation::NodeBipartite{},
+		observation::Khalil2016{},
+		observation::Pseudocosts{},
+		observation::NodeBipartite{},
+	};
+	STATIC_REQUIRE(decltype(data_func)::read_only);
+	data_func.before_reset(model);
+	auto const [node_obs, khalil_obs, pseudocosts_obs, _] = data_func.extract(model, false);
+
+	auto khalil = observation::Khalil2016{};
+	khalil.before_reset(model);
+	auto node_bipartite = observation::NodeBipartite{};
+	node_bipartite.before_reset(model);
+	auto const expected_node_obs = node_bipartite.extract(model, false);
+	auto const expected_khalil_obs = khalil.extract(model, false);
+	auto const expected_pseudocosts_obs = observation::Pseudocosts{}.extract(model, false);
+
+	REQUIRE(same(node_obs.value().variable_features, expected_node_obs.value().variable_features));
+	REQUIRE(same(node_obs.value().row_features, expected_node_obs.value().row_features));
+	REQUIRE(node_obs.value().edge_features == expected_node_obs.value().edge_features);
+	REQUIRE(same(khalil_obs.value().features, expected_khalil_obs.value().features));
+	REQUIRE(same(pseudocosts_obs.value(), expected_pseudocosts_obs.value()));
+}
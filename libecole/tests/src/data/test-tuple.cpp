@@ -25,3 +25,15 @@ TEST_CASE("Combine data functions into a tuple", "[data]") {
 	REQUIRE(std::get<0>(data) == 1);
 	REQUIRE(std::get<1>(data) == 2.0);  // NOLINT(readability-magic-numbers)
 }
+
+TEST_CASE("Read-only data functions are combined concurrently", "[data]") {
+	auto data_func =
+		TupleFunction{ReadOnlyIntDataFunc{0}, IntDataFunc{1}, ReadOnlyIntDataFunc{2}, ReadOnlyIntDataFunc{3}};
+	STATIC_REQUIRE_FALSE(decltype(data_func)::read_only);
+	auto model = get_model();
+
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const data = data_func.extract(model, false);
+	REQUIRE(data == std::tuple{1, 2, 3, 4});
+}
@@ -25,3 +25,13 @@ TEST_CASE("Combine data extraction functions into a vector", "[data]") {
 	REQUIRE(data[0] == 2);
 	REQUIRE(data[1] == 3);
 }
+
+TEST_CASE("Read-only data functions are combined concurrently into a vector", "[data]") {
+	auto data_func = VectorFunction<ReadOnlyIntDataFunc>{{{1}, {2}, {3}}};
+	STATIC_REQUIRE(decltype(data_func)::read_only);
+	auto model = get_model();
+
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	REQUIRE(data_func.extract(model, false) == std::vector{2, 3, 4});
+}
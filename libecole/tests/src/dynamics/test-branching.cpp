@@ -65,6 +65,38 @@ TEST_CASE("BranchingDynamics functional tests", "[dynamics]") {
 	}
 }
 
+TEST_CASE("BranchingDynamics solve with a direct policy", "[dynamics]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	auto dyn = dynamics::BranchingDynamics{pseudo_candidates};
+	auto model = get_model();
+
+	SECTION("Solve instance") {
+		auto n_calls = 0;
+		dyn.solve_with_policy(model, [&n_calls](auto& /*model*/, auto const& action_set) -> Defaultable<std::size_t> {
+			REQUIRE(action_set.has_value());
+			++n_calls;
+			return action_set.value()[0];
+		});
+		REQUIRE(n_calls > 0);
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Forward policy exceptions") {
+		auto const policy = [](auto& /*model*/, auto const& /*action_set*/) -> Defaultable<std::size_t> {
+			throw std::runtime_error{"Policy error"};
+		};
+		REQUIRE_THROWS_AS(dyn.solve_with_policy(model, policy), std::runtime_error);
+	}
+
+	SECTION("Throw on invalid branching variable") {
+		auto const action = model.variables().size() + 1;
+		auto const policy = [action](auto& /*model*/, auto const& /*action_set*/) -> Defaultable<std::size_t> {
+			return action;
+		};
+		REQUIRE_THROWS_AS(dyn.solve_with_policy(model, policy), std::invalid_argument);
+	}
+}
+
 TEST_CASE("BranchingDynamics handles limits", "[dynamics]") {
 	bool const pseudo_candidates = GENERATE(true, false);
 	auto dyn = dynamics::BranchingDynamics{pseudo_candidates};
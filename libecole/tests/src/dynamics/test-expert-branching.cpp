@@ -0,0 +1,92 @@
+#include <stdexcept>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xsort.hpp>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/dynamics/expert-branching.hpp"
+
+#include "conftest.hpp"
+#include "dynamics/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("ExpertBranchingDynamics unit tests", "[unit][dynamics]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	bool const follow_expert = GENERATE(true, false);
+	auto const policy = [follow_expert](auto const& action_set, auto const& /*model*/) -> Defaultable<std::size_t> {
+		if (follow_expert) {
+			return action_set.value().expert_action;
+		}
+		return action_set.value().candidates[0];
+	};
+	dynamics::unit_tests(dynamics::ExpertBranchingDynamics{pseudo_candidates, 100, {}, 5}, policy);
+}
+
+TEST_CASE("ExpertBranchingDynamics functional tests", "[dynamics]") {
+	std::size_t const n_threads = GENERATE(0, 2);
+	auto dyn = dynamics::ExpertBranchingDynamics{false, {}, {}, {}, n_threads};
+	auto model = get_model();
+
+	SECTION("Return valid action set") {
+		auto const [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		REQUIRE(action_set.has_value());
+		auto const& cands = action_set.value().candidates;
+		REQUIRE(cands.size() > 0);
+		REQUIRE(xt::all(cands < model.lp_columns().size()));
+		REQUIRE(xt::unique(cands).size() == cands.size());
+		REQUIRE(action_set.value().scores.size() == cands.size());
+		REQUIRE(action_set.value().exact.size() == cands.size());
+		auto const best = xt::argmax(action_set.value().scores)();
+		REQUIRE(action_set.value().expert_action == cands[best]);
+	}
+
+	SECTION("Solve instance with the expert") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			REQUIRE(action_set.has_value());
+			std::tie(done, action_set) = dyn.step_dynamics(model, ecole::Default);
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Throw on invalid branching variable") {
+		auto const [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		auto const action = model.lp_columns().size() + 1;
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, action), std::invalid_argument);
+	}
+}
+
+TEST_CASE("ExpertBranchingDynamics find the same optimum as BranchingDynamics", "[dynamics][slow]") {
+	auto const solve = [](auto dyn) {
+		auto model = get_model();
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, ecole::Default);
+		}
+		REQUIRE(model.is_solved());
+		return model.primal_bound();
+	};
+
+	auto const expected = solve(dynamics::BranchingDynamics{});
+	// Reused child bounds and domain reductions must not prune the optimum
+	REQUIRE(solve(dynamics::ExpertBranchingDynamics{false, {}, {}, {}, 0}) == Approx(expected));
+	REQUIRE(solve(dynamics::ExpertBranchingDynamics{false, {}, {}, {}, 2}) == Approx(expected));
+}
+
+TEST_CASE("ExpertBranchingDynamics solve with a direct policy", "[dynamics]") {
+	auto dyn = dynamics::ExpertBranchingDynamics{};
+	auto model = get_model();
+	auto n_calls = 0;
+	dyn.solve_with_policy(model, [&n_calls](auto& /*model*/, auto const& action_set) -> Defaultable<std::size_t> {
+		REQUIRE(action_set.has_value());
+		++n_calls;
+		return action_set.value().expert_action;
+	});
+	REQUIRE(n_calls > 0);
+	REQUIRE(model.is_solved());
+}
@@ -23,6 +23,21 @@ TEST_CASE("PrimalSearchDynamics unit tests", "[unit][dynamics]") {
 		});
 }
 
+TEST_CASE("PrimalSearchDynamics solve with a direct policy", "[dynamics]") {
+	auto const trials_per_node = GENERATE(1, 5);
+	auto dyn = dynamics::PrimalSearchDynamics{trials_per_node};
+	auto model = get_model();
+	auto n_calls = 0;
+	dyn.solve_with_policy(
+		model, [&n_calls](auto& /*model*/, auto const& action_set) -> dynamics::PrimalSearchDynamics::Action {
+			REQUIRE(action_set.has_value());
+			++n_calls;
+			return {{}, {}};
+		});
+	REQUIRE(n_calls > 0);
+	REQUIRE(model.is_solved());
+}
+
 TEST_CASE("PrimalSearchDynamics functional tests", "[dynamics]") {
 	const auto trials_per_node = 5;
 	auto dyn = dynamics::PrimalSearchDynamics{trials_per_node};
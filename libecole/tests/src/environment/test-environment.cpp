@@ -1,4 +1,7 @@
+#include <cstddef>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -11,6 +14,7 @@
 #include "ecole/random.hpp"
 #include "ecole/reward/constant.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/coroutine.hpp"
 
 #include "conftest.hpp"
 
@@ -27,7 +31,7 @@ namespace dynamics {
 struct TestDynamics {
 	using Action = double;
 
-	enum class Calls { seed, reset, step };
+	enum class Calls { seed, reset, step, policy };
 
 	static std::size_t constexpr max_call_lenght = 10;
 	std::vector<Calls> calls;
@@ -47,13 +51,37 @@ struct TestDynamics {
 		last_action = action;
 		return {calls.size() >= max_call_lenght, None};
 	}
+
+	template <typename Policy> auto solve_with_policy(scip::Model& model, Policy const& policy) -> void {
+		while (calls.size() < max_call_lenght) {
+			calls.push_back(Calls::policy);
+			last_action = policy(model, None);
+		}
+	}
 };
 
 }  // namespace dynamics
 
+namespace observation {
+
+/**
+ * Dummy observation function that counts its extractions.
+ */
+struct CountingObservation {
+	std::size_t n_extractions = 0;
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	auto extract(scip::Model& /*model*/, bool /*done*/) -> std::size_t { return ++n_extractions; }
+};
+
+}  // namespace observation
+
 namespace environment {
 
 using TestEnv = Environment<dynamics::TestDynamics, observation::Nothing, reward::Constant, information::Nothing>;
+using CountingEnv =
+	Environment<dynamics::TestDynamics, observation::CountingObservation, reward::Constant, information::Nothing>;
 
 }  // namespace environment
 }  // namespace ecole
@@ -64,6 +92,18 @@ using TestEnv = Environment<dynamics::TestDynamics, observation::Nothing, reward
 
 using namespace ecole;
 
+TEST_CASE("Environments replay actions without extracting intermediate observations", "[env]") {
+	auto env = environment::CountingEnv{};
+	auto const actions = std::vector{1.0, 2.0, 3.0};
+	std::size_t const n_actions = GENERATE(0, 2, 3);
+
+	auto [obs, action_set, reward, done, info] = env.replay(problem_file, actions, n_actions);
+	REQUIRE_FALSE(done);
+	// Only the root and final states are observed
+	REQUIRE(env.observation_function().n_extractions == 2);
+	REQUIRE(obs.value() == 2);
+}
+
 TEST_CASE("Environments accept SCIP parameters", "[env]") {
 	auto constexpr name = "concurrent/paramsetprefix";
 	auto const value = std::string("testname");
@@ -101,7 +141,66 @@ TEST_CASE("Environments have MDP API", "[env]") {
 		}
 	}
 
-	SECTION("Cannot transition without reseting") { REQUIRE_THROWS_AS(env.step(some_action), MarkovError); }
+	SECTION("Replay a sequence of actions") {
+		auto const actions = std::vector{1.0, 2.0, 3.0};
+		auto [obs, action_set, reward, done, info] = env.replay(problem_file, actions, 2);
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step, Calls::step});
+		REQUIRE(env.dynamics().last_action == actions[1]);
+		std::tie(obs, action_set, reward, done, info) = env.step(some_action);
+		REQUIRE(env.dynamics().last_action == some_action);
+	}
+
+	SECTION("Solve with a direct policy") {
+		env.solve_with_policy(scip::Model::from_file(problem_file), [&](auto const& /*obs*/, auto const& /*action_set*/) {
+			return some_action;
+		});
+		REQUIRE(env.dynamics().calls.front() == Calls::seed);
+		REQUIRE(env.dynamics().calls.back() == Calls::policy);
+		REQUIRE(env.dynamics().last_action == some_action);
+		REQUIRE_THROWS_AS(env.step(some_action), MarkovError);
+	}
+
+	SECTION("Step asynchronously") {
+		auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+		env.step_async(some_action);
+		REQUIRE_THROWS_AS(env.step(some_action), MarkovError);
+		REQUIRE_THROWS_AS(env.step_async(some_action), MarkovError);
+		std::tie(obs, action_set, reward, done, info) = env.step_wait();
+		REQUIRE_FALSE(env.poll());
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step});
+		REQUIRE(env.dynamics().last_action == some_action);
+		REQUIRE_THROWS_AS(env.step_wait(), MarkovError);
+	}
+
+	SECTION("Cannot move with a pending asynchronous step") {
+		env.reset(problem_file);
+		env.step_async(some_action);
+		REQUIRE_THROWS_AS(environment::TestEnv{std::move(env)}, MarkovError);
+		auto other = environment::TestEnv{};
+		REQUIRE_THROWS_AS(other = std::move(env), MarkovError);
+		env.step_wait();
+		auto moved = environment::TestEnv{std::move(env)};
+		REQUIRE(moved.dynamics().last_action == some_action);
+	}
+
+	SECTION("Cannot step asynchronously with the context coroutine backend") {
+		env.reset(problem_file);
+		env.model().set_coroutine_backend(utility::CoroutineBackend::Context);
+		REQUIRE_THROWS_AS(env.step_async(some_action), std::logic_error);
+		REQUIRE_FALSE(env.poll());
+	}
+
+	SECTION("Step into an existing observation") {
+		auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+		std::tie(action_set, reward, done, info) = env.step_into(obs, some_action);
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step});
+		REQUIRE(env.dynamics().last_action == some_action);
+	}
+
+	SECTION("Cannot transition without reseting") {
+		REQUIRE_THROWS_AS(env.step(some_action), MarkovError);
+		REQUIRE_THROWS_AS(env.step_async(some_action), MarkovError);
+	}
 
 	SECTION("Cannot transition past termination") {
 		auto [obs, action_set, reward, done, info] = env.reset(problem_file);
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/presolved-cache.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Presolved cache reuses presolved instances", "[env]") {
+	auto cache = environment::PresolvedCache{};
+	auto const params = std::map<std::string, scip::Param>{};
+
+	auto model1 = cache.get(problem_file, params);
+	REQUIRE(model1.stage() == SCIP_STAGE_PROBLEM);
+	REQUIRE(cache.statistics().n_misses == 1);
+	REQUIRE(cache.statistics().n_hits == 0);
+
+	auto model2 = cache.get(problem_file, params);
+	REQUIRE(model2.stage() == SCIP_STAGE_PROBLEM);
+	REQUIRE(model1 != model2);
+	REQUIRE(cache.statistics().n_hits == 1);
+	REQUIRE(cache.statistics().hit_rate() == 0.5);
+	REQUIRE(cache.size() == 1);
+
+	SECTION("Presolved instances are smaller") {
+		auto const original = scip::Model::from_file(problem_file);
+		REQUIRE(model1.variables().size() <= original.variables().size());
+	}
+
+	SECTION("Different presolving parameters make different templates") {
+		[[maybe_unused]] auto const model3 = cache.get(problem_file, {{"limits/nodes", 1LL}});
+		REQUIRE(cache.statistics().n_misses == 2);
+		REQUIRE(cache.size() == 2);
+	}
+
+	SECTION("Other parameters share templates but are set on the copies") {
+		auto model3 = cache.get(problem_file, {{"branching/scorefunc", 'p'}});
+		REQUIRE(cache.statistics().n_hits == 2);
+		REQUIRE(cache.size() == 1);
+		REQUIRE(model3.get_param<char>("branching/scorefunc") == 'p');
+	}
+
+	SECTION("Templates are evicted past capacity") {
+		auto small_cache = environment::PresolvedCache{1};
+		[[maybe_unused]] auto const model3 = small_cache.get(problem_file, params);
+		[[maybe_unused]] auto const model4 = small_cache.get(problem_file, {{"limits/nodes", 1LL}});
+		REQUIRE(small_cache.size() == 1);
+	}
+}
+
+TEST_CASE("Presolved cache presolves modified files again", "[env]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto const filename = tmp_folder.make_subpath(".mps");
+	std::filesystem::copy_file(problem_file, filename);
+	auto cache = environment::PresolvedCache{};
+	auto const params = std::map<std::string, scip::Param>{};
+
+	[[maybe_unused]] auto const model1 = cache.get(filename.string(), params);
+	auto const mtime = std::filesystem::last_write_time(filename);
+	std::filesystem::last_write_time(filename, mtime + std::chrono::hours{1});
+	[[maybe_unused]] auto const model2 = cache.get(filename.string(), params);
+	REQUIRE(cache.statistics().n_misses == 2);
+	REQUIRE(cache.statistics().n_hits == 0);
+}
+
+TEST_CASE("Environments reset from presolved cache", "[env]") {
+	auto env = environment::Branching<>{};
+	env.presolved_cache() = std::make_shared<environment::PresolvedCache>();
+
+	for (auto i = 0; i < 2; ++i) {
+		auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+		REQUIRE_FALSE(done);
+		std::tie(obs, action_set, reward, done, info) = env.step(action_set.value()[0]);
+	}
+	auto const stats = env.presolved_cache()->statistics();
+	REQUIRE(stats.n_hits == 1);
+	// Reset durations are recorded, not only the time to get the model
+	REQUIRE(stats.n_hit_resets == 1);
+	REQUIRE(stats.n_miss_resets == 1);
+	REQUIRE(stats.hits_reset_time > 0.);
+	REQUIRE(stats.misses_reset_time > 0.);
+}
@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/vector-environment.hpp"
+#include "ecole/exception.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Generate copies of the test problem with a small node limit to get short episodes. */
+class TestGenerator : public instance::InstanceGenerator {
+public:
+	std::size_t n_generated = 0;
+	/** Number of instances generated before the generator is exhausted. */
+	std::size_t n_max = std::numeric_limits<std::size_t>::max();
+	/** Whether instances are solved (here, interrupted) as soon as they are reset. */
+	bool solved_on_reset = false;
+
+	auto next() -> scip::Model override {
+		++n_generated;
+		auto model = get_model();
+		model.set_param("limits/totalnodes", 3);
+		if (solved_on_reset) {
+			model.set_param("limits/time", 0.);
+		}
+		return model;
+	}
+	void seed(Seed /*seed*/) override {}
+	[[nodiscard]] auto done() const -> bool override { return n_generated >= n_max; }
+};
+
+using TestVectorEnv = environment::VectorEnvironment<
+	dynamics::BranchingDynamics,
+	observation::Nothing,
+	reward::IsDone,
+	information::Nothing>;
+
+}  // namespace
+
+TEST_CASE("Vector environments step batches of environments", "[env]") {
+	auto constexpr n_envs = 4;
+	auto constexpr n_workers = 2;
+	auto generator = std::make_shared<TestGenerator>();
+	auto env = TestVectorEnv{n_envs, generator, n_workers};
+	env.seed(0);
+
+	auto [obs, action_sets, rewards, dones, infos] = env.reset();
+	REQUIRE(env.size() == n_envs);
+	REQUIRE(env.n_workers() == n_workers);
+	REQUIRE(obs.size() == n_envs);
+	REQUIRE(action_sets.size() == n_envs);
+	REQUIRE(rewards.size() == n_envs);
+	REQUIRE(infos.size() == n_envs);
+	REQUIRE(generator->n_generated >= n_envs);
+
+	SECTION("Finished environments are automatically reset") {
+		auto n_done = std::size_t{0};
+		for (auto step = 0; step < 10; ++step) {
+			auto actions = std::vector<TestVectorEnv::Action>{};
+			for (auto const& action_set : action_sets) {
+				REQUIRE(action_set.has_value());
+				actions.emplace_back(action_set.value()[0]);
+			}
+			std::tie(obs, action_sets, rewards, dones, infos) = env.step(actions);
+			REQUIRE(dones.size() == n_envs);
+			for (auto done : dones) {
+				n_done += done ? 1 : 0;
+			}
+		}
+		REQUIRE(n_done > 0);
+		REQUIRE(generator->n_generated >= n_envs + n_done);
+	}
+
+	SECTION("Actions must match the number of environments") {
+		REQUIRE_THROWS_AS(env.step({}), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Vector environments do not reset forever", "[env]") {
+	auto generator = std::make_shared<TestGenerator>();
+
+	SECTION("Stop after a number of instances solved on reset") {
+		auto constexpr max_reset_trials = 3;
+		generator->solved_on_reset = true;
+		auto env = TestVectorEnv{1, generator, 1, max_reset_trials};
+		REQUIRE_THROWS_AS(env.reset(), std::runtime_error);
+		REQUIRE(generator->n_generated == max_reset_trials);
+	}
+
+	SECTION("Stop when the instance generator is exhausted") {
+		generator->n_max = 1;
+		auto env = TestVectorEnv{2, generator, 1};
+		REQUIRE_THROWS_AS(env.reset(), IteratorExhausted);
+		REQUIRE(generator->n_generated == 1);
+	}
+}
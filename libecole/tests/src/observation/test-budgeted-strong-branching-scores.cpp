@@ -0,0 +1,94 @@
+#include <cmath>
+#include <cstddef>
+#include <optional>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/data/step-context.hpp"
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+#include "ecole/observation/strong-branching-scores.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "conftest.hpp"
+#include "observation/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("BudgetedStrongBranchingScores unit tests", "[unit][obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	std::size_t const n_threads = GENERATE(0, 2);
+	observation::unit_tests(observation::BudgetedStrongBranchingScores{pseudo_candidates, 10, 1., 5, n_threads});
+}
+
+TEST_CASE("BudgetedStrongBranchingScores without limits match StrongBranchingScores", "[obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = observation::BudgetedStrongBranchingScores{pseudo_candidates}.extract(model, false);
+	auto const expected = observation::StrongBranchingScores{pseudo_candidates}.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	REQUIRE(expected.has_value());
+	auto const& scores = obs.value().scores;
+	REQUIRE(scores.size() == expected.value().size());
+	REQUIRE(xt::all(xt::isnan(scores) == xt::isnan(expected.value())));
+	REQUIRE(xt::allclose(xt::filter(scores, !xt::isnan(scores)), xt::filter(expected.value(), !xt::isnan(scores))));
+	REQUIRE(xt::all(xt::filter(obs.value().exact, !xt::isnan(scores))));
+}
+
+TEST_CASE("BudgetedStrongBranchingScores within a budget", "[obs]") {
+	auto model = get_model();
+	// Without incumbent, neither SCIP strong branching nor the LP copies stop children at the cutoff bound
+	scip::call(SCIPsetHeuristics, model.get_scip_ptr(), SCIP_PARAMSETTING_OFF, true);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto context = data::StepContext{};
+	auto const n_cands = context.lp_branch_cands(model).variables.size();
+	REQUIRE(n_cands > 1);
+
+	SECTION("Only evaluate the top-k candidates") {
+		std::size_t const n_threads = GENERATE(0, 1, 3);
+		auto const obs_func = observation::BudgetedStrongBranchingScores{false, {}, {}, 1, n_threads};
+		auto const candidates = obs_func.evaluate(model, context);
+		REQUIRE(candidates.size() == n_cands);
+		REQUIRE(candidates.front().evaluated);
+		for (std::size_t cand_idx = 1; cand_idx < candidates.size(); ++cand_idx) {
+			REQUIRE_FALSE(candidates[cand_idx].evaluated);
+			REQUIRE_FALSE(candidates[cand_idx].exact);
+		}
+	}
+
+	SECTION("Do not evaluate candidates after the time limit") {
+		auto const obs_func = observation::BudgetedStrongBranchingScores{false, {}, 0.};
+		auto const obs = obs_func.extract_in_context(model, false, context);
+		REQUIRE(obs.has_value());
+		auto const& scores = obs.value().scores;
+		REQUIRE(xt::filter(scores, !xt::isnan(scores)).size() == n_cands);
+		REQUIRE_FALSE(xt::any(obs.value().exact));
+	}
+
+	SECTION("Evaluate candidates concurrently on LP copies") {
+		auto const obs_func = observation::BudgetedStrongBranchingScores{false, {}, {}, {}, 4};
+		for (auto const& cand : obs_func.evaluate(model, context)) {
+			REQUIRE(cand.evaluated);
+			REQUIRE(cand.score >= 0);
+			REQUIRE(cand.down_bound >= SCIPgetLPObjval(model.get_scip_ptr()) - 1e-6);
+		}
+	}
+
+	SECTION("Scores on LP copies match SCIP strong branching") {
+		auto const expected = observation::BudgetedStrongBranchingScores{}.extract_in_context(model, false, context);
+		auto const obs =
+			observation::BudgetedStrongBranchingScores{false, {}, {}, {}, 2}.extract_in_context(model, false, context);
+		REQUIRE(expected.has_value());
+		REQUIRE(obs.has_value());
+		auto const& scores = obs.value().scores;
+		auto const& expected_scores = expected.value().scores;
+		auto const is_cand = !xt::isnan(expected_scores);
+		REQUIRE(xt::all(xt::isnan(scores) == !is_cand));
+		// Gains on the copies are relative to their own LP objective, this checks they translate to SCIP bounds
+		REQUIRE(xt::allclose(xt::filter(scores, is_cand), xt::filter(expected_scores, is_cand), 1e-4, 1e-6));
+	}
+}
@@ -3,9 +3,12 @@
 #include <type_traits>
 
 #include <catch2/catch.hpp>
+#include <scip/cons_linear.h>
+#include <scip/scip.h>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/hutter-2011.hpp"
+#include "ecole/scip/utils.hpp"
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
@@ -100,6 +103,8 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 			auto const q75_degree = get_feature(Features::node_degree_75q);
 			REQUIRE(is_sorted(min_degree, q25_degree, q75_degree, max_degree));
 			REQUIRE(is_sorted(0., get_feature(Features::edge_density), 1.));
+			REQUIRE(is_sorted(0., get_feature(Features::clustering_coef_mean), 1.));
+			REQUIRE(0. <= get_feature(Features::clustering_coef_std));
 		}
 
 		SECTION("LP based features") {
@@ -127,3 +132,138 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Hutter2011 estimates variable graph features beyond the budget", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+
+	auto model = get_model();
+	auto exact_func = observation::Hutter2011{};
+	exact_func.before_reset(model);
+	auto const exact_obs = exact_func.extract(model, false).value();
+	auto sampled_func = observation::Hutter2011{std::size_t{0}, 10};
+	sampled_func.before_reset(model);
+	auto const sampled_obs = sampled_func.extract(model, false).value();
+
+	auto exact = [&](auto feat) { return exact_obs.features[static_cast<std::size_t>(feat)]; };
+	auto sampled = [&](auto feat) { return sampled_obs.features[static_cast<std::size_t>(feat)]; };
+	auto error = [&](auto feat) { return sampled_obs.standard_errors[static_cast<std::size_t>(feat)]; };
+
+	SECTION("Exact features have no error") { REQUIRE(xt::all(xt::equal(exact_obs.standard_errors, 0.))); }
+
+	SECTION("Sampled features come with their errors") {
+		REQUIRE(sampled_obs.standard_errors.shape() == sampled_obs.features.shape());
+		REQUIRE(error(Features::node_degree_mean) >= 0.);
+		REQUIRE(error(Features::edge_density) >= 0.);
+		REQUIRE(std::isnan(error(Features::node_degree_max)));
+		REQUIRE(error(Features::clustering_coef_mean) >= 0.);
+		REQUIRE(std::isnan(error(Features::clustering_coef_std)));
+		REQUIRE(is_sorted(0., sampled(Features::clustering_coef_mean), 1.));
+		REQUIRE(sampled(Features::node_degree_max) <= exact(Features::node_degree_max));
+		REQUIRE(sampled(Features::node_degree_min) >= exact(Features::node_degree_min));
+	}
+
+	SECTION("Other features are not sampled") {
+		REQUIRE(sampled(Features::nb_nonzero_coefs) == exact(Features::nb_nonzero_coefs));
+		REQUIRE(error(Features::nb_nonzero_coefs) == 0.);
+	}
+}
+
+TEST_CASE("Hutter2011 estimates clustering coefficients beyond the triangle budget", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+
+	auto model = get_model();
+	auto exact_func = observation::Hutter2011{};
+	exact_func.before_reset(model);
+	auto const exact_obs = exact_func.extract(model, false).value();
+	// The variable graph is built in full, but triangles are not counted
+	auto sampled_func = observation::Hutter2011{{}, 10, std::size_t{0}};
+	sampled_func.before_reset(model);
+	auto const sampled_obs = sampled_func.extract(model, false).value();
+
+	auto exact = [&](auto feat) { return exact_obs.features[static_cast<std::size_t>(feat)]; };
+	auto sampled = [&](auto feat) { return sampled_obs.features[static_cast<std::size_t>(feat)]; };
+	auto error = [&](auto feat) { return sampled_obs.standard_errors[static_cast<std::size_t>(feat)]; };
+
+	SECTION("Degree features are exact") {
+		for (auto const feat : {Features::node_degree_mean, Features::node_degree_max, Features::edge_density}) {
+			REQUIRE(sampled(feat) == exact(feat));
+			REQUIRE(error(feat) == 0.);
+		}
+	}
+
+	SECTION("Clustering coefficients are sampled") {
+		REQUIRE(error(Features::clustering_coef_mean) >= 0.);
+		REQUIRE(std::isnan(error(Features::clustering_coef_std)));
+		REQUIRE(is_sorted(0., sampled(Features::clustering_coef_mean), 1.));
+	}
+}
+
+TEST_CASE("Hutter2011 LP features are the same when reused on the same instance", "[obs]") {
+	auto obs_func = observation::Hutter2011{};
+	auto extract_lp_features = [&obs_func]() {
+		auto model = get_model();
+		obs_func.before_reset(model);
+		auto const obs = obs_func.extract(model, false).value();
+		auto const begin = static_cast<std::size_t>(observation::Hutter2011Obs::Features::lp_slack_mean);
+		return xt::eval(xt::view(obs.features, xt::range(begin, begin + 4)));
+	};
+
+	auto const first_lp_features = extract_lp_features();
+	REQUIRE(obs_func.n_lp_solved() == 1);
+	auto const second_lp_features = extract_lp_features();
+	REQUIRE(obs_func.n_lp_solved() == 1);
+	REQUIRE(first_lp_features == second_lp_features);
+}
+
+TEST_CASE("Hutter2011 LP objective matches the relaxation solved by SCIP", "[obs][slow]") {
+	using Features = observation::Hutter2011Obs::Features;
+
+	auto model = get_model();
+	auto obs_func = observation::Hutter2011{};
+	obs_func.before_reset(model);
+	auto const obs = obs_func.extract(model, false).value();
+
+	// The relaxation as it used to be computed, on a copy with all variables made continuous
+	auto relax_model = model.copy();
+	auto* const relax_scip = relax_model.get_scip_ptr();
+	for (auto* const var : relax_model.variables()) {
+		SCIP_Bool infeasible = FALSE;
+		scip::call(SCIPchgVarType, relax_scip, var, SCIP_VARTYPE_CONTINUOUS, &infeasible);
+	}
+	scip::call(SCIPsolve, relax_scip);
+	REQUIRE(SCIPgetStatus(relax_scip) == SCIP_STATUS_OPTIMAL);
+	auto const expected = SCIPgetSolOrigObj(relax_scip, SCIPgetBestSol(relax_scip));
+
+	auto const lp_objective = obs.features[static_cast<std::size_t>(Features::lp_objective_value)];
+	REQUIRE(lp_objective == Approx(expected).epsilon(1e-6));
+}
+
+TEST_CASE("Hutter2011 LP features of an infeasible relaxation", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+
+	auto model = get_model();
+	auto* const scip = model.get_scip_ptr();
+	auto variables = model.variables();
+	SCIP_VAR* var = *std::find_if(variables.begin(), variables.end(), [scip](auto* v) {
+		return !SCIPisInfinity(scip, SCIPvarGetUbGlobal(v));
+	});
+	SCIP_CONS* cons = nullptr;
+	SCIP_Real coef = 1.;
+	auto const lhs = SCIPvarGetUbGlobal(var) + 1.;
+	scip::call(SCIPcreateConsBasicLinear, scip, &cons, "infeasible", 1, &var, &coef, lhs, SCIPinfinity(scip));
+	scip::call(SCIPaddCons, scip, cons);
+	scip::call(SCIPreleaseCons, scip, &cons);
+
+	auto obs_func = observation::Hutter2011{};
+	obs_func.before_reset(model);
+	auto const obs = obs_func.extract(model, false).value();
+	auto get_feature = [&obs](auto feat) { return obs.features[static_cast<std::size_t>(feat)]; };
+
+	REQUIRE(std::isnan(get_feature(Features::lp_slack_mean)));
+	REQUIRE(std::isnan(get_feature(Features::lp_slack_max)));
+	REQUIRE(std::isnan(get_feature(Features::lp_slack_l2)));
+	// Minimization problem, for which an infeasible LP has an infinitely bad objective
+	REQUIRE(SCIPgetObjsense(scip) == SCIP_OBJSENSE_MINIMIZE);
+	REQUIRE(std::isinf(get_feature(Features::lp_objective_value)));
+	REQUIRE(get_feature(Features::lp_objective_value) > 0.);
+}
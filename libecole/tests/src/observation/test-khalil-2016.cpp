@@ -1,3 +1,7 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
 #include <catch2/catch.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/transform.hpp>
@@ -19,7 +23,8 @@ using namespace ecole;
 
 TEST_CASE("Khalil2016 unit tests", "[unit][obs]") {
 	auto const pseudo = GENERATE(true, false);
-	observation::unit_tests(observation::Khalil2016{pseudo});
+	auto const candidates_only = GENERATE(true, false);
+	observation::unit_tests(observation::Khalil2016{pseudo, candidates_only});
 }
 
 template <typename Tensor, typename T = typename Tensor::value_type>
@@ -163,3 +168,81 @@ TEST_CASE("Khalil2016 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Khalil2016 only observe branching candidates", "[obs]") {
+	auto const pseudo = GENERATE(true, false);
+	auto full_func = observation::Khalil2016{pseudo};
+	auto compact_func = observation::Khalil2016{pseudo, true};
+	auto model = get_model();
+	full_func.before_reset(model);
+	compact_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const full_obs = full_func.extract(model, false).value();
+	auto const compact_obs = compact_func.extract(model, false).value();
+
+	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	REQUIRE(compact_obs.features.shape(0) == branch_cands.size());
+	REQUIRE(compact_obs.features.shape(1) == observation::Khalil2016Obs::n_features);
+	REQUIRE(compact_obs.candidates.size() == branch_cands.size());
+	REQUIRE(full_obs.candidates == compact_obs.candidates);
+
+	for (auto const [cand_idx, var] : views::enumerate(branch_cands)) {
+		auto const var_idx = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		REQUIRE(compact_obs.candidates[cand_idx] == var_idx);
+		auto const compact_row = xt::row(compact_obs.features, static_cast<std::ptrdiff_t>(cand_idx));
+		REQUIRE(compact_row == xt::row(full_obs.features, var_idx));
+	}
+}
+
+/** Population standard deviation computed with the two-pass formula, to check the single pass computation. */
+auto two_pass_std(std::vector<double> const& values) -> double {
+	if (values.empty()) {
+		return 0.;
+	}
+	auto const n_values = static_cast<double>(values.size());
+	auto mean = 0.;
+	for (auto const val : values) {
+		mean += val / n_values;
+	}
+	auto variance = 0.;
+	for (auto const val : values) {
+		variance += (val - mean) * (val - mean) / n_values;
+	}
+	return std::sqrt(variance);
+}
+
+TEST_CASE("Khalil2016 active constraint coefficient std matches a two-pass computation", "[obs]") {
+	using Features = observation::Khalil2016Obs::Features;
+
+	auto obs_func = observation::Khalil2016{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false).value();
+	auto* const scip = model.get_scip_ptr();
+
+	for (auto* const var : model.lp_branch_cands()) {
+		auto* const col = SCIPvarGetCol(var);
+		auto* const* const rows = SCIPcolGetRows(col);
+		auto const* const vals = SCIPcolGetVals(col);
+		// Unit weights and dual cost weights, the other two depend on the candidates of each row
+		auto unit_weighted = std::vector<double>{};
+		auto dual_weighted = std::vector<double>{};
+		for (auto k = 0; k < SCIPcolGetNNonz(col); ++k) {
+			auto* const row = rows[k];
+			auto const activity = SCIPgetRowActivity(scip, row);
+			auto const is_active = (SCIProwGetLPPos(row) >= 0) && SCIProwIsInLP(row) &&
+			                       (SCIPisEQ(scip, activity, SCIProwGetRhs(row)) ||
+			                        SCIPisEQ(scip, activity, SCIProwGetLhs(row)));
+			if (is_active) {
+				unit_weighted.push_back(std::abs(vals[k]));
+				dual_weighted.push_back(std::abs(SCIProwGetDualsol(row)) * std::abs(vals[k]));
+			}
+		}
+
+		auto const var_idx = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		auto get_feature = [&](auto feat) { return obs.features(var_idx, static_cast<std::size_t>(feat)); };
+		REQUIRE(get_feature(Features::active_coef_weight1_stddev) == Approx(two_pass_std(unit_weighted)).margin(1e-9));
+		REQUIRE(get_feature(Features::active_coef_weight4_stddev) == Approx(two_pass_std(dual_weighted)).margin(1e-9));
+	}
+}
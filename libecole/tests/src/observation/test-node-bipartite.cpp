@@ -1,9 +1,14 @@
 #include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xview.hpp>
 
+#include "ecole/dynamics/branching.hpp"
 #include "ecole/observation/node-bipartite.hpp"
 
 #include "conftest.hpp"
@@ -15,6 +20,10 @@ TEST_CASE("NodeBipartite unit tests", "[unit][obs]") {
 	observation::unit_tests(observation::NodeBipartite{});
 }
 
+TEST_CASE("NodeBipartite in lower precision unit tests", "[unit][obs]") {
+	observation::unit_tests(observation::NodeBipartiteF32I32{});
+}
+
 TEST_CASE("NodeBipartite return correct observation", "[obs]") {
 	auto cache = GENERATE(true, false);
 	auto obs_func = observation::NodeBipartite{cache};
@@ -53,3 +62,151 @@ TEST_CASE("NodeBipartite return correct observation", "[obs]") {
 		REQUIRE_FALSE(xt::all(xt::isnan(obs.row_features)));
 	}
 }
+
+TEST_CASE("NodeBipartite incremental extraction matches full extraction", "[obs]") {
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{false, true};
+	auto dynamics = dynamics::BranchingDynamics{};
+	auto model = get_model();
+
+	full_func.before_reset(model);
+	incremental_func.before_reset(model);
+	auto [done, action_set] = dynamics.reset_dynamics(model);
+	auto const same = [](auto const& a, auto const& b) {
+		return (a.shape() == b.shape()) && xt::all(xt::equal(a, b) || (xt::isnan(a) && xt::isnan(b)));
+	};
+	for (auto i = 0; (i < 10) && !done; ++i) {
+		auto const full_obs = full_func.extract(model, done).value();
+		auto const incremental_obs = incremental_func.extract(model, done).value();
+		REQUIRE(same(full_obs.variable_features, incremental_obs.variable_features));
+		REQUIRE(same(full_obs.row_features, incremental_obs.row_features));
+		REQUIRE(same(full_obs.edge_features.indices, incremental_obs.edge_features.indices));
+		REQUIRE(same(full_obs.edge_features.values, incremental_obs.edge_features.values));
+		std::tie(done, action_set) = dynamics.step_dynamics(model, action_set.value()[0]);
+	}
+}
+
+TEST_CASE("NodeBipartite incremental extraction matches full extraction with cuts at every node", "[obs][slow]") {
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{false, true};
+	auto dynamics = dynamics::BranchingDynamics{};
+	auto model = get_model();
+	// Separate at every node so that rows are added and removed along the episode
+	model.set_params({
+		{"separating/maxrounds", -1},
+		{"separating/gomory/freq", 1},
+		{"separating/cmir/freq", 1},
+	});
+
+	full_func.before_reset(model);
+	incremental_func.before_reset(model);
+	auto [done, action_set] = dynamics.reset_dynamics(model);
+	auto const same = [](auto const& a, auto const& b) {
+		return (a.shape() == b.shape()) && xt::all(xt::equal(a, b) || (xt::isnan(a) && xt::isnan(b)));
+	};
+	for (auto i = 0; (i < 100) && !done; ++i) {
+		auto const full_obs = full_func.extract(model, done).value();
+		auto const incremental_obs = incremental_func.extract(model, done).value();
+		REQUIRE(same(full_obs.variable_features, incremental_obs.variable_features));
+		REQUIRE(same(full_obs.row_features, incremental_obs.row_features));
+		REQUIRE(same(full_obs.edge_features.indices, incremental_obs.edge_features.indices));
+		REQUIRE(same(full_obs.edge_features.values, incremental_obs.edge_features.values));
+		std::tie(done, action_set) = dynamics.step_dynamics(model, action_set.value()[0]);
+	}
+}
+
+TEST_CASE("NodeBipartite extract into an existing observation", "[obs]") {
+	auto obs_func = observation::NodeBipartite{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const expected_obs = obs_func.extract(model, false).value();
+
+	auto optional_obs = std::optional<observation::NodeBipartiteObs>{};
+	obs_func.extract_into(model, false, optional_obs);
+	REQUIRE(optional_obs.has_value());
+	auto const* const variable_features_data = optional_obs->variable_features.data();
+	auto const* const row_features_data = optional_obs->row_features.data();
+
+	SECTION("Observation written is the same as the one extracted") {
+		auto const& obs = optional_obs.value();
+		REQUIRE(obs.variable_features.shape() == expected_obs.variable_features.shape());
+		REQUIRE(obs.row_features.shape() == expected_obs.row_features.shape());
+		REQUIRE(obs.edge_features.indices == expected_obs.edge_features.indices);
+		REQUIRE(obs.edge_features.values == expected_obs.edge_features.values);
+	}
+
+	SECTION("Memory is reused when extracting again in the same state") {
+		obs_func.extract_into(model, false, optional_obs);
+		REQUIRE(optional_obs->variable_features.data() == variable_features_data);
+		REQUIRE(optional_obs->row_features.data() == row_features_data);
+	}
+}
+
+TEST_CASE("NodeBipartite in lower precision matches double precision", "[obs]") {
+	auto double_func = observation::NodeBipartite{};
+	auto float_func = observation::NodeBipartiteF32I32{};
+	auto model = get_model();
+	double_func.before_reset(model);
+	float_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const double_obs = double_func.extract(model, false).value();
+	auto const float_obs = float_func.extract(model, false).value();
+
+	auto const close = [](auto const& a, auto const& b) {
+		auto const a_cast = xt::eval(xt::cast<float>(a));
+		return (a.shape() == b.shape()) && xt::all(xt::isclose(a_cast, b, 1e-5, 1e-6, true));
+	};
+	REQUIRE(close(double_obs.variable_features, float_obs.variable_features));
+	REQUIRE(close(double_obs.row_features, float_obs.row_features));
+	REQUIRE(close(double_obs.edge_features.values, float_obs.edge_features.values));
+	auto const double_indices = xt::eval(xt::cast<std::int32_t>(double_obs.edge_features.indices));
+	REQUIRE(double_indices == float_obs.edge_features.indices);
+}
+
+TEST_CASE("NodeBipartite edges in compressed rows match coordinate format", "[obs]") {
+	// Edges are written in compressed rows directly, or converted from the cache of incremental extraction
+	auto const [cache, incremental] = GENERATE(std::pair{false, false}, std::pair{true, false}, std::pair{false, true});
+	auto coo_func = observation::NodeBipartite{};
+	auto csr_func = observation::NodeBipartite{cache, incremental, true};
+	auto model = get_model();
+	coo_func.before_reset(model);
+	csr_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const coo_obs = coo_func.extract(model, false).value();
+	auto const csr_obs = csr_func.extract(model, false).value();
+
+	REQUIRE(csr_obs.edge_features.nnz() == 0);
+	auto expected = utility::csr_matrix<double>{};
+	utility::coo_to_csr(coo_obs.edge_features, expected);
+	REQUIRE(csr_obs.edge_features_csr == expected);
+	// Rows are already sorted in coordinate format, so values keep the same order
+	REQUIRE(csr_obs.edge_features_csr.values == coo_obs.edge_features.values);
+}
+
+TEST_CASE("NodeBipartite extraction with multiple threads matches a single thread", "[obs]") {
+	auto const cache = GENERATE(true, false);
+	auto serial_func = observation::NodeBipartite{cache};
+	auto parallel_func = observation::NodeBipartite{cache, false, false, 4};
+	auto dynamics = dynamics::BranchingDynamics{};
+	auto model = get_model();
+	if (cache) {
+		model.disable_cuts();
+	}
+
+	serial_func.before_reset(model);
+	parallel_func.before_reset(model);
+	auto [done, action_set] = dynamics.reset_dynamics(model);
+	// Features are computed the same way by all threads, so even the nan must be at the same places
+	auto const identical = [](auto const& a, auto const& b) {
+		return (a.shape() == b.shape()) && xt::all(xt::equal(a, b) || (xt::isnan(a) && xt::isnan(b)));
+	};
+	for (auto i = 0; (i < 3) && !done; ++i) {
+		auto const serial_obs = serial_func.extract(model, done).value();
+		auto const parallel_obs = parallel_func.extract(model, done).value();
+		REQUIRE(identical(serial_obs.variable_features, parallel_obs.variable_features));
+		REQUIRE(identical(serial_obs.row_features, parallel_obs.row_features));
+		REQUIRE(serial_obs.edge_features == parallel_obs.edge_features);
+		std::tie(done, action_set) = dynamics.step_dynamics(model, action_set.value()[0]);
+	}
+}
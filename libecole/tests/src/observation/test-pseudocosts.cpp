@@ -3,6 +3,7 @@
 #include <catch2/catch.hpp>
 #include <scip/scip.h>
 
+#include "ecole/data/step-context.hpp"
 #include "ecole/observation/pseudocosts.hpp"
 
 #include "conftest.hpp"
@@ -11,7 +12,8 @@
 using namespace ecole;
 
 TEST_CASE("Pseudocosts unit tests", "[unit][obs]") {
-	observation::unit_tests(observation::Pseudocosts{});
+	auto const candidates_only = GENERATE(true, false);
+	observation::unit_tests(observation::Pseudocosts{candidates_only});
 }
 
 TEST_CASE("Pseudocosts return pseudo costs array", "[obs]") {
@@ -33,3 +35,35 @@ TEST_CASE("Pseudocosts return pseudo costs array", "[obs]") {
 		REQUIRE(pseudocost > 0);
 	}
 }
+
+TEST_CASE("Pseudocosts only observe branching candidates", "[obs]") {
+	auto full_func = observation::Pseudocosts{};
+	auto compact_func = observation::Pseudocosts{true};
+	auto model = get_model();
+	full_func.before_reset(model);
+	compact_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const full_costs = full_func.extract(model, false).value();
+	auto const compact_costs = compact_func.extract(model, false).value();
+
+	auto const branch_cands = model.lp_branch_cands();
+	REQUIRE(compact_costs.size() == branch_cands.size());
+	for (std::size_t cand_idx = 0; cand_idx < branch_cands.size(); ++cand_idx) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(branch_cands[cand_idx]));
+		REQUIRE(compact_costs[cand_idx] == full_costs[var_index]);
+	}
+}
+
+TEST_CASE("Pseudocosts take branching candidates from a context", "[obs]") {
+	auto obs_func = observation::Pseudocosts{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto context = data::StepContext{};
+	auto const obs = obs_func.extract_in_context(model, false, context);
+
+	REQUIRE(obs.has_value());
+	for (auto const var_index : context.lp_branch_cands(model).indices) {
+		REQUIRE(obs.value()[var_index] > 0);
+	}
+}
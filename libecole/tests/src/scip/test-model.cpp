@@ -3,6 +3,8 @@
 #include <limits>
 #include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <scip/scip.h>
@@ -12,6 +14,7 @@
 #include "ecole/scip/exception.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
+#include "ecole/utility/coroutine.hpp"
 
 #include "conftest.hpp"
 
@@ -28,6 +31,49 @@ TEST_CASE("Equality comparison", "[scip]") {
 	REQUIRE(model != model.copy_orig());
 }
 
+TEST_CASE("Concurrent copies of a model", "[scip]") {
+	auto constexpr n_copies = 16;
+	auto model = scip::Model::from_file(problem_file);
+	auto const copy_many = [&model = std::as_const(model)]() {
+		auto futures = std::vector<std::future<scip::Model>>{};
+		for (auto i = 0; i < n_copies; ++i) {
+			futures.push_back(std::async(std::launch::async, [&model] { return model.copy_orig(); }));
+		}
+		auto copies = std::vector<scip::Model>{};
+		for (auto& fut : futures) {
+			copies.push_back(fut.get());
+		}
+		return copies;
+	};
+
+	SECTION("Copies are identical") {
+		for (auto const& copy : copy_many()) {
+			REQUIRE(copy.name() == model.name());
+			REQUIRE(copy.variables().size() == model.variables().size());
+			REQUIRE(copy.constraints().size() == model.constraints().size());
+		}
+	}
+
+	SECTION("Copies see modifications made after previous copies") {
+		copy_many();
+		model.set_param("limits/nodes", 7LL);
+		for (auto const& copy : copy_many()) {
+			REQUIRE(copy.get_param<SCIP_Longint>("limits/nodes") == 7);
+		}
+	}
+
+	SECTION("Copies see modifications made through a pointer kept from before previous copies") {
+		auto* const scip = model.get_scip_ptr();
+		copy_many();
+		auto* const var = SCIPgetOrigVars(scip)[0];
+		auto const new_ub = SCIPvarGetLbOriginal(var) + 1.;
+		scip::call(SCIPchgVarUb, scip, var, new_ub);
+		for (auto const& copy : copy_many()) {
+			REQUIRE(SCIPvarGetUbOriginal(copy.variables()[0]) == new_ub);
+		}
+	}
+}
+
 TEST_CASE("Create model from file", "[scip]") {
 	auto model = scip::Model::from_file(problem_file);
 }
@@ -177,6 +223,12 @@ TEST_CASE("Map parameter management", "[scip]") {
 
 TEST_CASE("Iterative branching", "[scip][slow]") {
 	auto model = get_model();
+	auto const backend = GENERATE(
+		utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadPool, utility::CoroutineBackend::Context);
+	if ((backend == utility::CoroutineBackend::Context) && !utility::has_context_coroutine_backend) {
+		return;
+	}
+	model.set_coroutine_backend(backend);
 	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
 
 	SECTION("Destructed before done") {}
@@ -199,6 +251,31 @@ TEST_CASE("Iterative branching", "[scip][slow]") {
 	}
 }
 
+TEST_CASE("Iterative branching filters branchrule methods", "[scip][slow]") {
+	using Where = scip::callback::BranchruleCall::Where;
+	auto model = get_model();
+	auto constructor = scip::callback::BranchruleConstructor{};
+
+	SECTION("Pause only on LP branching") {
+		constructor.pause_on_external = false;
+		constructor.pause_on_pseudo = false;
+		auto fcall = model.solve_iter(constructor);
+		while (fcall.has_value()) {
+			REQUIRE(std::get<scip::callback::BranchruleCall>(fcall.value()).where == Where::LP);
+			fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Never pause") {
+		constructor.pause_on_lp = false;
+		constructor.pause_on_external = false;
+		constructor.pause_on_pseudo = false;
+		REQUIRE_FALSE(model.solve_iter(constructor).has_value());
+		REQUIRE(model.is_solved());
+	}
+}
+
 TEST_CASE("Iterative solving", "[scip][slow]") {
 	auto model = get_model();
 	auto const constructors = std::array<scip::callback::DynamicConstructor, 2>{
@@ -1,5 +1,8 @@
 #include <catch2/catch.hpp>
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 #include <variant>
 
 #include "ecole/none.hpp"
@@ -8,12 +11,27 @@
 
 using namespace ecole;
 
+namespace {
+
+/** Generate all the coroutine backends supported on this platform. */
+auto generate_backend() -> utility::CoroutineBackend {
+	auto const backend = GENERATE(
+		utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadPool, utility::CoroutineBackend::Context);
+	if ((backend == utility::CoroutineBackend::Context) && !utility::has_context_coroutine_backend) {
+		return utility::CoroutineBackend::Thread;
+	}
+	return backend;
+}
+
+}  // namespace
+
 TEST_CASE("Coroutine manage ressources", "[utility]") {
 	using Coroutine = utility::Coroutine<NoneType, NoneType>;
 	using Executor = Coroutine::Executor;
+	auto const backend = generate_backend();
 
 	SECTION("Coroutine teminate immediatly") {
-		auto co = Coroutine{[](Executor const& /*executor*/) {}};
+		auto co = Coroutine{backend, [](Executor const& /*executor*/) {}};
 
 		SECTION("Being waited on") {
 			auto ret = co.wait();
@@ -22,7 +40,7 @@ TEST_CASE("Coroutine manage ressources", "[utility]") {
 	}
 
 	SECTION("Coroutine is killed in execution") {
-		auto co = Coroutine{[](Executor& executor) {
+		auto co = Coroutine{backend, [](Executor& executor) {
 			auto message = executor.yield(None);
 			do {
 				if (Executor::is_stop(message)) {
@@ -42,9 +60,10 @@ TEST_CASE("Coroutine manage ressources", "[utility]") {
 TEST_CASE("Coroutine can return values", "[utility]") {
 	using Coroutine = utility::Coroutine<int, NoneType>;
 	using Executor = Coroutine::Executor;
+	auto const backend = generate_backend();
 	auto const max = GENERATE(0, 1, 5);
 
-	auto co = Coroutine{[max](Executor& executor) {
+	auto co = Coroutine{backend, [max](Executor& executor) {
 		for (int i = 0; i < max; ++i) {
 			auto message = executor.yield(i);
 			if (Executor::is_stop(message)) {
@@ -65,9 +84,10 @@ TEST_CASE("Coroutine can return values", "[utility]") {
 TEST_CASE("Coroutine can send messages", "[utility]") {
 	using Coroutine = utility::Coroutine<int, int>;
 	using Executor = Coroutine::Executor;
+	auto const backend = generate_backend();
 	auto const max = GENERATE(0, 1, 5);
 
-	auto co = Coroutine{[max](Executor& executor) {
+	auto co = Coroutine{backend, [max](Executor& executor) {
 		int last_message = 0;
 		while (true) {
 			auto message = executor.yield(last_message);
@@ -86,3 +106,81 @@ TEST_CASE("Coroutine can send messages", "[utility]") {
 	REQUIRE(ret.has_value());
 	REQUIRE(ret.value() == message);
 }
+
+TEST_CASE("Coroutine forward executor exceptions", "[utility]") {
+	using Coroutine = utility::Coroutine<int, int>;
+	using Executor = Coroutine::Executor;
+	auto const backend = generate_backend();
+
+	auto co = Coroutine{backend, [](Executor& executor) {
+		executor.yield(0);
+		throw std::runtime_error{"Executor error"};
+	}};
+
+	REQUIRE(co.wait().has_value());
+	co.resume(0);
+	REQUIRE_THROWS_AS(co.wait(), std::runtime_error);
+}
+
+TEST_CASE("Context coroutine cannot be resumed from another thread", "[utility]") {
+	using Coroutine = utility::Coroutine<int, int>;
+	using Executor = Coroutine::Executor;
+	if (!utility::has_context_coroutine_backend) {
+		return;
+	}
+
+	auto co = Coroutine{utility::CoroutineBackend::Context, [](Executor& executor) {
+		while (!Executor::is_stop(executor.yield(0))) {
+		}
+	}};
+	REQUIRE(co.wait().has_value());
+	co.resume(0);
+	// Catch assertions are not thread safe, so the exception is checked on this thread.
+	auto other_thread_threw = false;
+	auto other_thread = std::thread{[&co, &other_thread_threw] {
+		try {
+			co.wait();
+		} catch (std::logic_error const&) {
+			other_thread_threw = true;
+		}
+	}};
+	other_thread.join();
+	REQUIRE(other_thread_threw);
+	REQUIRE(co.wait().has_value());
+}
+
+TEST_CASE("Coroutine can spin before parking", "[utility]") {
+	using Coroutine = utility::Coroutine<int, int>;
+	using Executor = Coroutine::Executor;
+	auto const backend = GENERATE(utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadPool);
+	auto const budget = GENERATE(std::size_t{1}, std::size_t{1000});
+	constexpr auto n_steps = 10;
+
+	auto const previous_budget = utility::coroutine_spin_budget();
+	utility::set_coroutine_spin_budget(budget);
+	utility::reset_coroutine_handoff_stats();
+	{
+		auto co = Coroutine{backend, [](Executor& executor) {
+			for (int i = 0; i < n_steps; ++i) {
+				if (Executor::is_stop(executor.yield(i))) {
+					break;
+				}
+			}
+		}};
+		for (int i = 0; i < n_steps; ++i) {
+			auto ret = co.wait();
+			REQUIRE(ret.has_value());
+			REQUIRE(ret.value() == i);
+			co.resume(0);
+		}
+		REQUIRE_FALSE(co.wait().has_value());
+	}
+	utility::set_coroutine_spin_budget(previous_budget);
+
+	auto const stats = utility::coroutine_handoff_stats();
+	if (std::thread::hardware_concurrency() > 1) {
+		REQUIRE(stats.n_spin_hits + stats.n_parks > 0);
+	} else {
+		REQUIRE(stats.n_spin_hits + stats.n_parks == 0);
+	}
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "utility/csr-graph.hpp"
+
+using namespace ecole;
+using GroupIncidence = utility::GroupIncidence;
+using CsrGraph = utility::CsrGraph;
+
+TEST_CASE("Clique expansion of groups in compressed sparse rows", "[utility][unit]") {
+	// Groups {0, 1, 2}, {2, 3}, {1, 2} (repeating the edge 1-2) and {4}, with node 5 in no group.
+	std::size_t constexpr n_nodes = 6;
+	std::size_t constexpr n_groups = 4;
+	auto constexpr group_of = std::array<std::size_t, 8>{1, 0, 0, 2, 1, 3, 0, 2};
+	auto constexpr node_of = std::array<std::size_t, 8>{3, 2, 0, 2, 2, 4, 1, 1};
+	auto const incidence = GroupIncidence{n_nodes, n_groups, group_of, node_of};
+
+	SECTION("Incidence groups nodes in both directions") {
+		REQUIRE(incidence.n_nodes() == n_nodes);
+		REQUIRE(incidence.n_groups() == n_groups);
+		REQUIRE(incidence.group_nodes(0).size() == 3);
+		REQUIRE(incidence.node_groups(2).size() == 3);
+		REQUIRE(incidence.node_groups(5).empty());
+		REQUIRE(incidence.expansion_work() == 3 * 2 + 2 * 1 + 2 * 1);
+	}
+
+	SECTION("Count distinct neighbours with a shared marker") {
+		auto marker = std::vector<std::size_t>(n_nodes, n_nodes);
+		auto constexpr expected = std::array<std::size_t, n_nodes>{2, 2, 3, 1, 0, 0};
+		for (std::size_t node = 0; node < n_nodes; ++node) {
+			REQUIRE(incidence.expansion_degree(node, marker) == expected[node]);
+		}
+	}
+
+	SECTION("Build graph with sorted neighbours") {
+		auto const graph = CsrGraph::clique_expansion(incidence);
+		REQUIRE(graph.n_nodes() == n_nodes);
+		REQUIRE(graph.n_edges() == 4);
+		auto const neighbors = graph.neighbors(2);
+		REQUIRE(std::vector<std::size_t>(neighbors.begin(), neighbors.end()) == std::vector<std::size_t>{0, 1, 3});
+		for (std::size_t node = 0; node < n_nodes; ++node) {
+			auto const node_neighbors = graph.neighbors(node);
+			REQUIRE(std::is_sorted(node_neighbors.begin(), node_neighbors.end()));
+			REQUIRE(std::find(node_neighbors.begin(), node_neighbors.end(), node) == node_neighbors.end());
+		}
+		REQUIRE(graph.degree(4) == 0);
+	}
+
+	SECTION("Check adjacency") {
+		auto const graph = CsrGraph::clique_expansion(incidence);
+		for (std::size_t node1 = 0; node1 < n_nodes; ++node1) {
+			for (std::size_t node2 = 0; node2 < n_nodes; ++node2) {
+				if (node1 != node2) {
+					REQUIRE(graph.are_connected(node1, node2) == incidence.share_group(node1, node2));
+				}
+			}
+		}
+		REQUIRE(graph.are_connected(0, 1));
+		REQUIRE_FALSE(graph.are_connected(0, 3));
+	}
+
+	SECTION("Count triangles") {
+		auto const graph = CsrGraph::clique_expansion(incidence);
+		// The only triangle is {0, 1, 2}.
+		REQUIRE(graph.triangle_counts() == std::vector<std::size_t>{1, 1, 1, 0, 0, 0});
+		REQUIRE(graph.triangle_work() >= 1);
+	}
+}
+
+TEST_CASE("Count triangles in a complete graph", "[utility][unit]") {
+	std::size_t constexpr n_nodes = 5;
+	auto const group_of = std::vector<std::size_t>(n_nodes, 0);
+	auto node_of = std::vector<std::size_t>(n_nodes);
+	std::iota(node_of.begin(), node_of.end(), std::size_t{0});
+	auto const graph = CsrGraph::clique_expansion(GroupIncidence{n_nodes, 1, group_of, node_of});
+
+	REQUIRE(graph.n_edges() == n_nodes * (n_nodes - 1) / 2);
+	// Each node belongs to as many triangles as pairs of other nodes.
+	auto const triangles = graph.triangle_counts();
+	REQUIRE(std::all_of(triangles.begin(), triangles.end(), [](auto n) { return n == 6; }));
+}
@@ -25,3 +25,28 @@ TEST_CASE("Sparse matrix unit unit tests", "[unit][utility]") {
 		REQUIRE(matrix_copy == matrix);
 	}
 }
+
+TEST_CASE("Sparse matrix conversion to compressed rows", "[unit][utility]") {
+	auto const matrix = utility::coo_matrix<double>{
+		{2., 4., 7., 1.},              // NOLINT(readability-magic-numbers)
+		{{2, 0, 2, 1}, {1, 1, 0, 2}},  // NOLINT(readability-magic-numbers)
+		{4, 3},                        // NOLINT(readability-magic-numbers)
+	};
+	auto csr = utility::csr_matrix<double>{};
+	utility::coo_to_csr(matrix, csr);
+
+	SECTION("Coefficients are grouped by rows in their original order") {
+		auto const expected = utility::csr_matrix<double>{
+			{4., 1., 2., 7.},  // NOLINT(readability-magic-numbers)
+			{1, 2, 1, 0},      // NOLINT(readability-magic-numbers)
+			{0, 1, 2, 4, 4},   // NOLINT(readability-magic-numbers)
+			{4, 3},            // NOLINT(readability-magic-numbers)
+		};
+		REQUIRE(csr == expected);
+	}
+
+	SECTION("To and from tuple") {
+		auto const csr_copy = utility::csr_matrix<double>::from_tuple(csr.to_tuple());
+		REQUIRE(csr_copy == csr);
+	}
+}
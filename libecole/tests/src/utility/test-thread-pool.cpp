@@ -0,0 +1,59 @@
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/thread-pool.hpp"
+
+using namespace ecole;
+
+TEST_CASE("ThreadPool run tasks", "[utility]") {
+	auto pool = utility::ThreadPool{};
+	auto count = std::atomic<int>{0};
+	auto futures = std::vector<std::future<void>>{};
+	for (auto i = 0; i < 10; ++i) {
+		futures.push_back(pool.submit([&count] { ++count; }));
+	}
+	for (auto& fut : futures) {
+		fut.get();
+	}
+	REQUIRE(count == 10);
+}
+
+TEST_CASE("ThreadPool reuse idle threads", "[utility]") {
+	auto pool = utility::ThreadPool{};
+	pool.submit([] {}).get();
+	REQUIRE(pool.n_threads() == 1);
+	pool.submit([] {}).get();
+	REQUIRE(pool.n_threads() == 1);
+}
+
+TEST_CASE("ThreadPool grows when all threads are busy", "[utility]") {
+	auto pool = utility::ThreadPool{};
+	auto release = std::promise<void>{};
+	auto released = release.get_future().share();
+	// The first task blocks until the second one has run, which would deadlock with a fixed size pool.
+	auto first = pool.submit([released] { released.wait(); });
+	auto second = pool.submit([&release] { release.set_value(); });
+	second.get();
+	first.get();
+	REQUIRE(pool.n_threads() == 2);
+}
+
+TEST_CASE("ThreadPool destroy task before future is ready", "[utility]") {
+	auto pool = utility::ThreadPool{};
+	auto resource = std::make_shared<int>(0);
+	auto weak_resource = std::weak_ptr<int>{resource};
+	auto fut = pool.submit([resource = std::move(resource)] {});
+	fut.get();
+	REQUIRE(weak_resource.expired());
+}
+
+TEST_CASE("ThreadPool forward exceptions", "[utility]") {
+	auto pool = utility::ThreadPool{};
+	auto fut = pool.submit([] { throw std::runtime_error{"Task error"}; });
+	REQUIRE_THROWS_AS(fut.get(), std::runtime_error);
+}
@@ -1,3 +1,5 @@
+#include <cstddef>
+#include <optional>
 #include <utility>
 
 #include <pybind11/pybind11.h>
@@ -6,8 +8,10 @@
 
 #include "ecole/dynamics/branching.hpp"
 #include "ecole/dynamics/configuring.hpp"
+#include "ecole/dynamics/expert-branching.hpp"
 #include "ecole/dynamics/nodesel.hpp"
 #include "ecole/dynamics/primal-search.hpp"
+#include "ecole/python/auto-class.hpp"
 #include "ecole/scip/model.hpp"
 
 #include "core.hpp"
@@ -143,6 +147,120 @@ void bind_submodule(pybind11::module_ const& m) {
 			)");
 	}
 
+	{
+		ecole::python::auto_class<ExpertBranchingActionSet>(m, "ExpertBranchingActionSet", R"(
+			Branching candidates with their strong branching evaluation.
+		)")
+			.def_auto_copy()
+			.def_auto_pickle("candidates", "scores", "exact", "expert_action")
+			.def_readwrite_xtensor("candidates", &ExpertBranchingActionSet::candidates, R"(
+				Indices of the branching candidate variables, by decreasing pseudocost score.
+
+				Variable indices are their position in the original problem (``SCIPvarGetProbindex``).
+			)")
+			.def_readwrite_xtensor(
+				"scores",
+				&ExpertBranchingActionSet::scores,
+				"Strong branching score of each candidate, estimated from the pseudocosts when not evaluated.")
+			.def_readwrite_xtensor(
+				"exact",
+				&ExpertBranchingActionSet::exact,
+				"Whether the score of each candidate was computed by strong branching to optimality.")
+			.def_readwrite(
+				"expert_action",
+				&ExpertBranchingActionSet::expert_action,
+				"Index of the candidate variable with the best score, the expert decision.");
+
+		dynamics_class<ExpertBranchingDynamics>{m, "ExpertBranchingDynamics", R"(
+			Single variable branching Dynamics with a strong branching expert.
+
+			Like :py:class:`BranchingDynamics`, but strong branching is done on the candidates every time
+			the control is given back to the user, and the result is given in the action set.
+			Branching then reuses the strong branching work within the same SCIP callback: domain reductions
+			found by strong branching are applied, and the dual bound of the children is set from strong
+			branching, rather than having SCIP solve the children LP again.
+			Observation, expert scores, and decision are hence recorded in a single pass.
+		)"}
+			.def_reset_dynamics(R"(
+				Start solving up to first branching node.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						An :py:class:`ExpertBranchingActionSet` with the candidates of the node and their scores.
+			)")
+			.def_step_dynamics(R"(
+				Branch and resume solving until next branching.
+
+				If strong branching found that a child of the chosen variable is infeasible, its domain is reduced
+				instead of branching, and the node is solved again.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					action:
+						The index of the variable to branch on, usually one of the ``action_set`` candidates.
+						If an explicit ``ecole.Default`` is passed, the expert decision
+						(:py:attr:`ExpertBranchingActionSet.expert_action`) is used.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						An :py:class:`ExpertBranchingActionSet` with the candidates of the node and their scores.
+			)")
+			.def_set_dynamics_random_state(R"(
+				Set seeds on the :py:class:`~ecole.scip.Model`.
+
+				Set seed parameters, including permutation, LP, and shift.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					rng:
+						The source of randomness. Passed by the environment.
+			)")
+			.def(
+				py::init<bool, std::optional<int>, std::optional<double>, std::optional<std::size_t>, std::size_t>(),
+				py::arg("pseudo_candidates") = false,
+				py::arg("iteration_limit") = std::nullopt,
+				py::arg("time_limit") = std::nullopt,
+				py::arg("top_k") = std::nullopt,
+				py::arg("n_threads") = 0,
+				R"(
+				Create new dynamics.
+
+				The strong branching budget is the same as in
+				:py:class:`~ecole.observation.BudgetedStrongBranchingScores`.
+
+				Parameters
+				----------
+				pseudo_candidates:
+					Whether the action set contains pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
+					or LP branching variable candidates (``SCIPgetLPBranchCands``).
+				iteration_limit:
+					Maximum number of LP iterations for each child of a candidate.
+				time_limit:
+					Wall clock time in seconds after which no new candidate is evaluated.
+				top_k:
+					Maximum number of candidates evaluated by strong branching,
+					the ones with the best pseudocost scores.
+				n_threads:
+					Number of threads evaluating candidates on independent copies of the current LP,
+					or zero to use SCIP strong branching.
+			)");
+	}
+
 	{
 		dynamics_class<ConfiguringDynamics>{m, "ConfiguringDynamics", R"(
 			Setting solving parameters Dynamics.
@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -7,6 +11,8 @@
 #include <pybind11/stl.h>
 #include <xtensor-python/pytensor.hpp>
 
+#include "ecole/data/step-context.hpp"
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
 #include "ecole/observation/hutter-2011.hpp"
 #include "ecole/observation/khalil-2016.hpp"
 #include "ecole/observation/milp-bipartite.hpp"
@@ -49,6 +55,213 @@ template <typename PyClass, typename... Args> auto def_extract(PyClass pyclass,
 		std::forward<Args>(args)...);
 }
 
+/**
+ * Helper function to bind the `extract_into` method of observation functions.
+ *
+ * Arrays of an observation exposed to Python are views on its memory, which must not be reallocated.
+ * The observation is therefore extracted directly in the given one, with the GIL released, only if all its arrays
+ * keep their shape.
+ * Otherwise the given observation is left untouched and a new one is returned.
+ */
+template <typename PyClass, typename Obs, typename... Args> auto def_extract_into(PyClass pyclass, Args&&... args) {
+	return pyclass.def(
+		"extract_into",
+		[](typename PyClass::type& self, scip::Model& model, bool done, py::object const& py_obs) -> py::object {
+			auto& obs = py_obs.cast<Obs&>();
+			auto new_obs = std::optional<Obs>{};
+			auto in_place = false;
+			{
+				auto const release = py::gil_scoped_release{};
+				auto context = data::StepContext{};
+				in_place = self.keeps_shapes_of(model, obs, context) && self.extract_into(model, done, obs, context);
+				if (!in_place) {
+					self.extract_into(model, done, new_obs, context);
+				}
+			}
+			if (in_place) {
+				return py_obs;
+			}
+			if (!new_obs.has_value()) {
+				return py::none();
+			}
+			return py::cast(std::move(new_obs).value());
+		},
+		py::arg("model"),
+		py::arg("done"),
+		py::arg("obs"),
+		std::forward<Args>(args)...);
+}
+
+/**
+ * Helper function to bind a sparse matrix with a given value and index type.
+ */
+template <typename Matrix> auto bind_coo_matrix(py::module_ const& m, char const* name, char const* doc) {
+	return ecole::python::auto_class<Matrix>(m, name, doc)
+		.def_auto_copy()
+		.def_auto_pickle("values", "indices", "shape")
+		.def_readwrite_xtensor("values", &Matrix::values, "A vector of non zero values in the matrix")
+		.def_readwrite_xtensor("indices", &Matrix::indices, R"(
+			A matrix holding the indices of non zero coefficient in the sparse matrix.
+
+			There are as many columns as there are non zero coefficients, and each row is a
+			dimension in the sparse matrix.
+		)")
+		.def_readwrite("shape", &Matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
+		.def_property_readonly("nnz", &Matrix::nnz);
+}
+
+/**
+ * Helper function to bind a compressed sparse row matrix with a given value and index type.
+ */
+template <typename Matrix> auto bind_csr_matrix(py::module_ const& m, char const* name, char const* doc) {
+	return ecole::python::auto_class<Matrix>(m, name, doc)
+		.def_auto_copy()
+		.def_auto_pickle("values", "indices", "indptr", "shape")
+		.def_readwrite_xtensor("values", &Matrix::values, "A vector of non zero values in the matrix, row by row.")
+		.def_readwrite_xtensor("indices", &Matrix::indices, "The column index of each non zero value.")
+		.def_readwrite_xtensor("indptr", &Matrix::indptr, R"(
+			Where each row starts in ``indices`` and ``values``.
+
+			Row ``i`` is stored from position ``indptr[i]`` to ``indptr[i+1]`` (excluded).
+		)")
+		.def_readwrite("shape", &Matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
+		.def_property_readonly("nnz", &Matrix::nnz)
+		.def(
+			"to_scipy",
+			[](py::object const& self) {
+				auto const csr_matrix = py::module_::import("scipy.sparse").attr("csr_matrix");
+				auto const data = py::make_tuple(self.attr("values"), self.attr("indices"), self.attr("indptr"));
+				return csr_matrix(data, py::arg("shape") = self.attr("shape"), py::arg("copy") = false);
+			},
+			R"(
+			Create a ``scipy.sparse.csr_matrix`` sharing the memory of this matrix.
+
+			The memory is only shared with signed indices, that is int32 or int64, as Scipy converts other types.
+		)");
+}
+
+/**
+ * Helper function to bind a NodeBipartiteObs of a given precision.
+ */
+template <typename Obs> auto bind_node_bipartite_obs(py::module_ const& m, char const* name, char const* doc) {
+	return ecole::python::auto_class<Obs>(m, name, doc)
+		.def_auto_copy()
+		.def_auto_pickle("variable_features", "row_features", "edge_features", "edge_features_csr")
+		.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
+				A matrix where each row represents a variable, and each column a feature of the variable.
+
+				Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+				hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+			)rst")
+		.def_readwrite_xtensor(
+			"row_features",
+			&Obs::row_features,
+			"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
+		.def_readwrite(
+			"edge_features",
+			&Obs::edge_features,
+			"The constraint matrix of the optimization problem, with rows for contraints and "
+			"columns for variables.")
+		.def_readwrite(
+			"edge_features_csr",
+			&Obs::edge_features_csr,
+			"Same as ``edge_features`` in compressed sparse rows, when extracted with ``csr=True``.");
+}
+
+/**
+ * Helper function to bind a NodeBipartite observation function of a given precision.
+ */
+template <typename Func> void bind_node_bipartite(py::module_ const& m, char const* name, std::string const& obs_name) {
+	auto const doc = std::string{R"(
+		Bipartite graph observation function on branch-and bound node.
+
+		This observation function extract structured :py:class:`)"} + obs_name + "`.";
+	auto node_bipartite = py::class_<Func>(m, name, doc.c_str());
+	node_bipartite.def(
+		py::init<bool, bool, bool, std::size_t>(),
+		py::arg("cache") = false,
+		py::arg("incremental") = false,
+		py::arg("csr") = false,
+		py::arg("n_threads") = 1,
+		R"(
+		Constructor for NodeBipartite.
+
+		Parameters
+		----------
+		cache :
+			Whether or not to cache static features within an episode.
+			Currently, this is only safe if cutting planes are disabled.
+		incremental :
+			Whether or not to reuse the edges and static features of LP rows that did not change since the
+			last extraction.
+			Unlike ``cache``, this is always exact.
+		csr :
+			Whether to write the edges in compressed sparse rows in ``edge_features_csr``, rather than in
+			coordinate format in ``edge_features``.
+		n_threads :
+			Number of threads sharing the extraction of variables, rows, and edges.
+			The observation is the same for any number of threads.
+			This is only worth it on large problems, and does not apply to incremental extraction.
+	)");
+	def_before_reset(node_bipartite, "Cache some feature not expected to change during an episode.");
+	def_extract(node_bipartite, ("Extract a new :py:class:`" + obs_name + "`.").c_str());
+	def_extract_into<decltype(node_bipartite), typename Func::Observation>(
+		node_bipartite,
+		("Extract in the given :py:class:`" + obs_name + "`, see :py:meth:`Khalil2016.extract_into`.").c_str());
+}
+
+/**
+ * Helper function to bind a MilpBipartiteObs of a given precision.
+ */
+template <typename Obs> auto bind_milp_bipartite_obs(py::module_ const& m, char const* name, char const* doc) {
+	return ecole::python::auto_class<Obs>(m, name, doc)
+		.def_auto_copy()
+		.def_auto_pickle("variable_features", "constraint_features", "edge_features", "edge_features_csr")
+		.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
+				A matrix where each row represents a variable, and each column a feature of the variable.
+
+				Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+				hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+			)rst")
+		.def_readwrite_xtensor(
+			"constraint_features",
+			&Obs::constraint_features,
+			"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
+		.def_readwrite(
+			"edge_features",
+			&Obs::edge_features,
+			"The constraint matrix of the optimization problem, with rows for contraints and columns for variables.")
+		.def_readwrite(
+			"edge_features_csr",
+			&Obs::edge_features_csr,
+			"Same as ``edge_features`` in compressed sparse rows, when extracted with ``csr=True``.");
+}
+
+/**
+ * Helper function to bind a MilpBipartite observation function of a given precision.
+ */
+template <typename Func> void bind_milp_bipartite(py::module_ const& m, char const* name, std::string const& obs_name) {
+	auto const doc = std::string{R"(
+		Bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
+
+		This observation function extract structured :py:class:`)"} + obs_name + "`.";
+	auto milp_bipartite = py::class_<Func>(m, name, doc.c_str());
+	milp_bipartite.def(py::init<bool, bool>(), py::arg("normalize") = false, py::arg("csr") = false, R"(
+		Constructor for MilpBipartite.
+
+		Parameters
+		----------
+		normalize :
+			Should the features be normalized?
+			This is recommended for some application such as deep learning models.
+		csr :
+			Whether to write the edges in compressed sparse rows in ``edge_features_csr``, rather than in
+			coordinate format in ``edge_features``.
+	)");
+	def_before_reset(milp_bipartite, R"(Do nothing.)");
+	def_extract(milp_bipartite, ("Extract a new :py:class:`" + obs_name + "`.").c_str());
+}
+
 /**
  * Observation module bindings definitions.
  */
@@ -59,27 +272,28 @@ void bind_submodule(py::module_ const& m) {
 
 	m.attr("Nothing") = py::type::of<Nothing>();
 
-	using coo_matrix = decltype(NodeBipartiteObs::edge_features);
-	ecole::python::auto_class<coo_matrix>(m, "coo_matrix", R"(
+	bind_coo_matrix<utility::coo_matrix<double>>(m, "coo_matrix", R"(
 		Sparse matrix in the coordinate format.
 
 		Similar to Scipy's ``scipy.sparse.coo_matrix`` or PyTorch ``torch.sparse``.
-	)")
-		.def_auto_copy()
-		.def_auto_pickle("values", "indices", "shape")
-		.def_readwrite_xtensor("values", &coo_matrix::values, "A vector of non zero values in the matrix")
-		.def_readwrite_xtensor("indices", &coo_matrix::indices, R"(
-			A matrix holding the indices of non zero coefficient in the sparse matrix.
+	)");
+	bind_coo_matrix<utility::coo_matrix<float, std::int32_t>>(
+		m, "coo_matrix_f32_i32", "Same as :py:class:`coo_matrix` with float32 values and int32 indices.");
+	bind_coo_matrix<utility::coo_matrix<float, std::int64_t>>(
+		m, "coo_matrix_f32_i64", "Same as :py:class:`coo_matrix` with float32 values and int64 indices.");
 
-			There are as many columns as there are non zero coefficients, and each row is a
-			dimension in the sparse matrix.
-		)")
-		.def_readwrite("shape", &coo_matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
-		.def_property_readonly("nnz", &coo_matrix::nnz);
+	bind_csr_matrix<utility::csr_matrix<double>>(m, "csr_matrix", R"(
+		Sparse matrix in the compressed sparse row format.
+
+		Similar to Scipy's ``scipy.sparse.csr_matrix``.
+	)");
+	bind_csr_matrix<utility::csr_matrix<float, std::int32_t>>(
+		m, "csr_matrix_f32_i32", "Same as :py:class:`csr_matrix` with float32 values and int32 indices.");
+	bind_csr_matrix<utility::csr_matrix<float, std::int64_t>>(
+		m, "csr_matrix_f32_i64", "Same as :py:class:`csr_matrix` with float32 values and int64 indices.");
 
 	// Node bipartite observation
-	auto node_bipartite_obs =
-		ecole::python::auto_class<NodeBipartiteObs>(m, "NodeBipartiteObs", R"(
+	auto node_bipartite_obs = bind_node_bipartite_obs<NodeBipartiteObs>(m, "NodeBipartiteObs", R"(
 		Bipartite graph observation for branch-and-bound nodes.
 
 		The optimization problem is represented as an heterogenous bipartite graph.
@@ -90,24 +304,7 @@ void bind_submodule(py::module_ const& m) {
 
 		Each variable and constraint node is associated with a vector of features.
 		Each edge is associated with the coefficient of the variable in the constraint.
-	)")
-			.def_auto_copy()
-			.def_auto_pickle("variable_features", "row_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &NodeBipartiteObs::variable_features, R"rst(
-					A matrix where each row represents a variable, and each column a feature of the variable.
-
-					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
-					hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
-				)rst")
-			.def_readwrite_xtensor(
-				"row_features",
-				&NodeBipartiteObs::row_features,
-				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
-			.def_readwrite(
-				"edge_features",
-				&NodeBipartiteObs::edge_features,
-				"The constraint matrix of the optimization problem, with rows for contraints and "
-				"columns for variables.");
+	)");
 
 	py::enum_<NodeBipartiteObs::VariableFeatures>(node_bipartite_obs, "VariableFeatures")
 		.value("objective", NodeBipartiteObs::VariableFeatures::objective)
@@ -137,26 +334,27 @@ void bind_submodule(py::module_ const& m) {
 		.value("dual_solution_value", NodeBipartiteObs::RowFeatures::dual_solution_value)
 		.value("scaled_age", NodeBipartiteObs::RowFeatures::scaled_age);
 
-	auto node_bipartite = py::class_<NodeBipartite>(m, "NodeBipartite", R"(
-		Bipartite graph observation function on branch-and bound node.
-
-		This observation function extract structured :py:class:`NodeBipartiteObs`.
-	)");
-	node_bipartite.def(py::init<bool>(), py::arg("cache") = false, R"(
-		Constructor for NodeBipartite.
-
-		Parameters
-		----------
-		cache :
-			Whether or not to cache static features within an episode.
-			Currently, this is only safe if cutting planes are disabled.
-	)");
-	def_before_reset(node_bipartite, "Cache some feature not expected to change during an episode.");
-	def_extract(node_bipartite, "Extract a new :py:class:`NodeBipartiteObs`.");
+	// Observations in lower precision share the same features enums
+	for (auto const& obs_class : std::array<py::object, 2>{
+			 bind_node_bipartite_obs<NodeBipartiteObsF32I32>(
+				 m,
+				 "NodeBipartiteObsF32I32",
+				 "Same as :py:class:`NodeBipartiteObs` with float32 features and int32 indices."),
+			 bind_node_bipartite_obs<NodeBipartiteObsF32I64>(
+				 m,
+				 "NodeBipartiteObsF32I64",
+				 "Same as :py:class:`NodeBipartiteObs` with float32 features and int64 indices."),
+		 }) {
+		obs_class.attr("VariableFeatures") = node_bipartite_obs.attr("VariableFeatures");
+		obs_class.attr("RowFeatures") = node_bipartite_obs.attr("RowFeatures");
+	}
+
+	bind_node_bipartite<NodeBipartite>(m, "NodeBipartite", "NodeBipartiteObs");
+	bind_node_bipartite<NodeBipartiteF32I32>(m, "NodeBipartiteF32I32", "NodeBipartiteObsF32I32");
+	bind_node_bipartite<NodeBipartiteF32I64>(m, "NodeBipartiteF32I64", "NodeBipartiteObsF32I64");
 
 	// MILP bipartite observation
-	auto milp_bipartite_obs =
-		ecole::python::auto_class<MilpBipartiteObs>(m, "MilpBipartiteObs", R"(
+	auto milp_bipartite_obs = bind_milp_bipartite_obs<MilpBipartiteObs>(m, "MilpBipartiteObs", R"(
 		Bipartite graph observation that represents the most recent MILP during presolving.
 
 		The optimization problem is represented as an heterogenous bipartite graph.
@@ -167,23 +365,7 @@ void bind_submodule(py::module_ const& m) {
 
 		Each variable and constraint node is associated with a vector of features.
 		Each edge is associated with the coefficient of the variable in the constraint.
-	)")
-			.def_auto_copy()
-			.def_auto_pickle("variable_features", "constraint_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &MilpBipartiteObs::variable_features, R"rst(
-					A matrix where each row represents a variable, and each column a feature of the variable.
-
-					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
-					hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
-				)rst")
-			.def_readwrite_xtensor(
-				"constraint_features",
-				&MilpBipartiteObs::constraint_features,
-				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
-			.def_readwrite(
-				"edge_features",
-				&MilpBipartiteObs::edge_features,
-				"The constraint matrix of the optimization problem, with rows for contraints and columns for variables.");
+	)");
 
 	py::enum_<MilpBipartiteObs::VariableFeatures>(milp_bipartite_obs, "VariableFeatures")
 		.value("objective", MilpBipartiteObs::VariableFeatures::objective)
@@ -199,22 +381,24 @@ void bind_submodule(py::module_ const& m) {
 	py::enum_<MilpBipartiteObs::ConstraintFeatures>(milp_bipartite_obs, "ConstraintFeatures")
 		.value("bias", MilpBipartiteObs::ConstraintFeatures::bias);
 
-	auto milp_bipartite = py::class_<MilpBipartite>(m, "MilpBipartite", R"(
-		Bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
-
-		This observation function extract structured :py:class:`MilpBipartiteObs`.
-	)");
-	milp_bipartite.def(py::init<bool>(), py::arg("normalize") = false, R"(
-		Constructor for MilpBipartite.
-
-		Parameters
-		----------
-		normalize :
-			Should the features be normalized?
-			This is recommended for some application such as deep learning models.
-	)");
-	def_before_reset(milp_bipartite, R"(Do nothing.)");
-	def_extract(milp_bipartite, "Extract a new :py:class:`MilpBipartiteObs`.");
+	// Observations in lower precision share the same features enums
+	for (auto const& obs_class : std::array<py::object, 2>{
+			 bind_milp_bipartite_obs<MilpBipartiteObsF32I32>(
+				 m,
+				 "MilpBipartiteObsF32I32",
+				 "Same as :py:class:`MilpBipartiteObs` with float32 features and int32 indices."),
+			 bind_milp_bipartite_obs<MilpBipartiteObsF32I64>(
+				 m,
+				 "MilpBipartiteObsF32I64",
+				 "Same as :py:class:`MilpBipartiteObs` with float32 features and int64 indices."),
+		 }) {
+		obs_class.attr("VariableFeatures") = milp_bipartite_obs.attr("VariableFeatures");
+		obs_class.attr("ConstraintFeatures") = milp_bipartite_obs.attr("ConstraintFeatures");
+	}
+
+	bind_milp_bipartite<MilpBipartite>(m, "MilpBipartite", "MilpBipartiteObs");
+	bind_milp_bipartite<MilpBipartiteF32I32>(m, "MilpBipartiteF32I32", "MilpBipartiteObsF32I32");
+	bind_milp_bipartite<MilpBipartiteF32I64>(m, "MilpBipartiteF32I64", "MilpBipartiteObsF32I64");
 
 	// Strong branching observation
 	auto strong_branching_scores = py::class_<StrongBranchingScores>(m, "StrongBranchingScores", R"(
@@ -243,6 +427,63 @@ void bind_submodule(py::module_ const& m) {
 	def_before_reset(strong_branching_scores, R"(Do nothing.)");
 	def_extract(strong_branching_scores, "Extract an array containing strong branching scores.");
 
+	// Budgeted strong branching observation
+	auto budgeted_strong_branching_scores_obs = ecole::python::auto_class<BudgetedStrongBranchingScoresObs>(
+		m, "BudgetedStrongBranchingScoresObs", R"(
+		Strong branching scores computed within a budget.
+
+		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+	)");
+	budgeted_strong_branching_scores_obs.def_auto_copy()
+		.def_auto_pickle("scores", "exact")
+		.def_readwrite_xtensor("scores", &BudgetedStrongBranchingScoresObs::scores, R"(
+			The score of each variable.
+
+			Candidates that are not evaluated by strong branching are scored with their pseudocosts.
+			Variables that are not branching candidates are filled with ``NaN``.
+		)")
+		.def_readwrite_xtensor(
+			"exact",
+			&BudgetedStrongBranchingScoresObs::exact,
+			"Whether the score of each variable was computed by strong branching to optimality.");
+
+	auto budgeted_strong_branching_scores =
+		py::class_<BudgetedStrongBranchingScores>(m, "BudgetedStrongBranchingScores", R"(
+		Strong branching score observation function within a budget.
+
+		Like :py:class:`StrongBranchingScores`, but candidates are evaluated by decreasing pseudocost score
+		until the budget is exhausted, optionally in parallel on independent copies of the LP.
+		This observation function extracts a :py:class:`BudgetedStrongBranchingScoresObs`.
+	)");
+	budgeted_strong_branching_scores.def(
+		py::init<bool, std::optional<int>, std::optional<double>, std::optional<std::size_t>, std::size_t>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("iteration_limit") = std::nullopt,
+		py::arg("time_limit") = std::nullopt,
+		py::arg("top_k") = std::nullopt,
+		py::arg("n_threads") = 0,
+		R"(
+		Create new observation.
+
+		Parameters
+		----------
+		pseudo_candidates:
+			Whether to score the pseudo candidate variables (when true) or LP candidate variables (when false).
+		iteration_limit:
+			Maximum number of LP iterations for each child of a candidate.
+			Scores of children hitting the limit are not exact.
+		time_limit:
+			Wall clock time in seconds after which no new candidate is evaluated.
+		top_k:
+			Maximum number of candidates evaluated by strong branching, the ones with the best pseudocost scores.
+		n_threads:
+			Number of threads evaluating candidates on independent copies of the current LP,
+			or zero to use SCIP strong branching.
+	)");
+	def_before_reset(budgeted_strong_branching_scores, R"(Do nothing.)");
+	def_extract(budgeted_strong_branching_scores, "Extract the scores and whether they are exact.");
+
 	// Pseudocosts observation
 	auto pseudocosts = py::class_<Pseudocosts>(m, "Pseudocosts", R"(
 		Pseudocosts observation function on branch-and-bound nodes.
@@ -259,8 +500,18 @@ void bind_submodule(py::module_ const& m) {
 		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
 		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 		Variables for which a pseudocost is not applicable are filled with ``NaN``.
+		When only candidates are observed, the array instead has one pseudocost per LP branching candidate, in the
+		order of the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+	)");
+	pseudocosts.def(py::init<bool>(), py::arg("candidates_only") = false, R"(
+		Create new observation.
+
+		Parameters
+		----------
+		candidates_only:
+			Whether to only compute the pseudocosts of the LP branching candidates, in a compact array
+			aligned with the ``action_set``, rather than an array with one element per variable.
 	)");
-	pseudocosts.def(py::init<>());
 	def_before_reset(pseudocosts, R"(Do nothing.)");
 	def_extract(pseudocosts, "Extract an array containing pseudocosts.");
 
@@ -279,18 +530,24 @@ void bind_submodule(py::module_ const& m) {
 			*Thirtieth AAAI Conference on Artificial Intelligence*. 2016.
 	)");
 	khalil2016_obs.def_auto_copy()
-		.def_auto_pickle("features")
+		.def_auto_pickle("features", "candidates")
 		.def_readwrite_xtensor("features", &Khalil2016Obs::features, R"rst(
 			A matrix where each row represents a variable, and each column a feature of the variable.
 
 			Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
 			hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 			Variables for which the features are not applicable are filled with ``NaN``.
+			When only candidates are observed, rows instead represent the branching candidates, in the order of
+			:py:attr:`Khalil2016Obs.candidates`.
 
 			The first :py:attr:`Khalil2016Obs.n_static_features` features columns are static (they do not
 			change through the solving process), and the remaining :py:attr:`Khalil2016Obs.n_dynamic_features`
 			are dynamic.
 		)rst")
+		.def_readwrite_xtensor(
+			"candidates",
+			&Khalil2016Obs::candidates,
+			"The index (``SCIPvarGetProbindex``) of each branching candidate, in the order of the ``action_set``.")
 		.def_readonly_static("n_static_features", &Khalil2016Obs::n_static_features)
 		.def_readonly_static("n_dynamic_features", &Khalil2016Obs::n_dynamic_features);
 
@@ -373,7 +630,11 @@ void bind_submodule(py::module_ const& m) {
 
 		This observation function extract structured :py:class:`Khalil2016Obs`.
 	)");
-	khalil2016.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
+	khalil2016.def(
+		py::init<bool, bool>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("candidates_only") = false,
+		R"(
 		Create new observation.
 
 		Parameters
@@ -381,9 +642,26 @@ void bind_submodule(py::module_ const& m) {
 		pseudo_candidates:
 				Whether the pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
 				or LP branching variable candidates (``SCIPgetPseudoBranchCands``) are observed.
+		candidates_only:
+				Whether the features matrix only has the rows of the branching candidates, in the order of
+				:py:attr:`Khalil2016Obs.candidates`, rather than one row per variable.
 	)");
 	def_before_reset(khalil2016, R"(Reset static features cache.)");
 	def_extract(khalil2016, "Extract the observation matrix.");
+	def_extract_into<decltype(khalil2016), Khalil2016Obs>(
+		khalil2016, R"(
+		Extract in the given :py:class:`Khalil2016Obs`.
+
+		Arrays viewed from an observation share its memory, and see the new values in place.
+		This is only done if none of the arrays change shape, otherwise the given observation and its
+		arrays are left untouched, and a new observation is returned instead.
+
+		Returns
+		-------
+		observation:
+			The given observation if it was updated in place, a new one otherwise, or ``None`` if there is no
+			observation.
+	)");
 
 	// Hutter2011 observation
 	auto hutter_obs = ecole::python::auto_class<Hutter2011Obs>(m, "Hutter2011Obs", R"(
@@ -399,8 +677,12 @@ void bind_submodule(py::module_ const& m) {
 			*International Conference on Learning and Intelligent Optimization*. 2011.
 	)");
 	hutter_obs.def_auto_copy()
-		.def_auto_pickle("features")
-		.def_readwrite_xtensor("features", &Hutter2011Obs::features, "A vector of instance features.");
+		.def_auto_pickle("features", "standard_errors")
+		.def_readwrite_xtensor("features", &Hutter2011Obs::features, "A vector of instance features.")
+		.def_readwrite_xtensor(
+			"standard_errors",
+			&Hutter2011Obs::standard_errors,
+			"The standard error of each feature, zero when exact, and NaN when estimated without known error.");
 
 	py::enum_<Hutter2011Obs::Features>(hutter_obs, "Features")
 		.value("nb_variables", Hutter2011Obs::Features::nb_variables)
@@ -420,6 +702,8 @@ void bind_submodule(py::module_ const& m) {
 		.value("node_degree_std", Hutter2011Obs::Features::node_degree_std)
 		.value("node_degree_25q", Hutter2011Obs::Features::node_degree_25q)
 		.value("node_degree_75q", Hutter2011Obs::Features::node_degree_75q)
+		.value("clustering_coef_mean", Hutter2011Obs::Features::clustering_coef_mean)
+		.value("clustering_coef_std", Hutter2011Obs::Features::clustering_coef_std)
 		.value("edge_density", Hutter2011Obs::Features::edge_density)
 		.value("lp_slack_mean", Hutter2011Obs::Features::lp_slack_mean)
 		.value("lp_slack_max", Hutter2011Obs::Features::lp_slack_max)
@@ -442,7 +726,28 @@ void bind_submodule(py::module_ const& m) {
 
 		This observation function extracts a structured :py:class:`Hutter2011Obs`.
 	)");
-	hutter.def(py::init<>());
+	hutter.def(
+		py::init<std::optional<std::size_t>, std::size_t, std::optional<std::size_t>>(),
+		py::arg("graph_budget") = std::nullopt,
+		py::arg("n_samples") = 1000,
+		py::arg("triangle_budget") = std::nullopt,
+		R"(
+		Constructor for Hutter2011.
+
+		Parameters
+		----------
+		graph_budget :
+			Maximum size of the variable graph, as the sum over constraints of their squared number of variables,
+			beyond which the variable graph features are estimated from a sample of variables.
+			Standard errors of the estimates are given in ``standard_errors``.
+			No limit if None.
+		n_samples :
+			Number of variables sampled to estimate the variable graph features (at least two).
+		triangle_budget :
+			Maximum number of steps of triangle counting, beyond which the clustering coefficients of a variable
+			graph within the graph budget are estimated by sampling pairs of neighbours.
+			No limit if None.
+	)");
 	def_before_reset(hutter, R"(Do nothing.)");
 	def_extract(hutter, "Extract the observation matrix.");
 }
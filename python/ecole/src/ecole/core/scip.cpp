@@ -11,6 +11,7 @@
 #include "ecole/scip/callback.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/scimpl.hpp"
+#include "ecole/utility/coroutine.hpp"
 
 #include "core.hpp"
 
@@ -59,7 +60,10 @@ void bind_submodule(py::module_ m) {
 		.def_auto_members(
 			python::Member{"priority", &BranchruleConstructor::priority},
 			python::Member{"max_depth", &BranchruleConstructor::max_depth},
-			python::Member{"max_bound_distance", &BranchruleConstructor::max_bound_distance});
+			python::Member{"max_bound_distance", &BranchruleConstructor::max_bound_distance},
+			python::Member{"pause_on_lp", &BranchruleConstructor::pause_on_lp},
+			python::Member{"pause_on_external", &BranchruleConstructor::pause_on_external},
+			python::Member{"pause_on_pseudo", &BranchruleConstructor::pause_on_pseudo});
 
 	python::auto_data_class<HeuristicConstructor>(m, "HeuristicConstructor")
 		.def_auto_members(
@@ -114,6 +118,11 @@ void bind_submodule(py::module_ m) {
 		.value("FreeTrans", SCIP_STAGE_FREETRANS)
 		.value("Free", SCIP_STAGE_FREE);
 
+	py::enum_<utility::CoroutineBackend>{m, "CoroutineBackend"}
+		.value("Thread", utility::CoroutineBackend::Thread)
+		.value("ThreadPool", utility::CoroutineBackend::ThreadPool)
+		.value("Context", utility::CoroutineBackend::Context);
+
 	// SCIP_HEURTIMING is simply a collection of Macros! We create a scope for holding the values.
 	struct HeurTiming {};
 	py::class_<HeurTiming>{m, "HeurTiming"}
@@ -190,6 +199,7 @@ void bind_submodule(py::module_ m) {
 		.def_property_readonly("primal_bound", &Model::primal_bound)
 		.def_property_readonly("dual_bound", &Model::dual_bound)
 
+		.def_property("coroutine_backend", &Model::coroutine_backend, &Model::set_coroutine_backend)
 		.def(
 			"solve_iter",
 			[](Model& self, py::args const& py_args) {
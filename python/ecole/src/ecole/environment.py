@@ -213,6 +213,11 @@ class Branching(Environment):
     __DefaultObservationFunction__ = ecole.observation.NodeBipartite
 
 
+class ExpertBranching(Environment):
+    __Dynamics__ = ecole.dynamics.ExpertBranchingDynamics
+    __DefaultObservationFunction__ = ecole.observation.NodeBipartite
+
+
 class Configuring(Environment):
     __Dynamics__ = ecole.dynamics.ConfiguringDynamics
 
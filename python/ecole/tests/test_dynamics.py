@@ -85,6 +85,33 @@ class TestBranching_Pseudocandidate(TestBranching):
         self.dynamics = ecole.dynamics.BranchingDynamics(True)
 
 
+class TestExpertBranching(DynamicsUnitTests):
+    @staticmethod
+    def assert_action_set(action_set):
+        assert isinstance(action_set, ecole.dynamics.ExpertBranchingActionSet)
+        assert action_set.candidates.size > 0
+        assert action_set.scores.shape == action_set.candidates.shape
+        assert action_set.exact.shape == action_set.candidates.shape
+        assert action_set.expert_action in action_set.candidates
+
+    @staticmethod
+    def policy(action_set):
+        return action_set.expert_action
+
+    @staticmethod
+    def bad_policy(action_set):
+        return 1 << 31
+
+    def setup_method(self, method):
+        self.dynamics = ecole.dynamics.ExpertBranchingDynamics(top_k=5)
+
+
+class TestExpertBranchingDefault(TestExpertBranching):
+    @staticmethod
+    def policy(action_set):
+        return ecole.Default
+
+
 class TestConfiguring(DynamicsUnitTests):
     @staticmethod
     def assert_action_set(action_set):
@@ -30,6 +30,7 @@ def pytest_generate_tests(metafunc):
             ecole.observation.MilpBipartite(),
             ecole.observation.StrongBranchingScores(True),
             ecole.observation.StrongBranchingScores(False),
+            ecole.observation.BudgetedStrongBranchingScores(top_k=3),
             ecole.observation.Pseudocosts(),
             ecole.observation.Khalil2016(),
             ecole.observation.Hutter2011(),
@@ -101,6 +102,33 @@ def test_NodeBipartite_observation(model):
     assert len(obs.RowFeatures.__members__) == obs.row_features.shape[1]
 
 
+@pytest.mark.parametrize("index_dtype", (np.int32, np.int64))
+def test_NodeBipartite_observation_precision(model, index_dtype):
+    """Observation of NodeBipartite can be extracted in float32 with smaller indices."""
+    obs_func = {np.int32: ecole.observation.NodeBipartiteF32I32, np.int64: ecole.observation.NodeBipartiteF32I64}
+    obs = make_obs(obs_func[index_dtype](), model)
+    assert_array(obs.variable_features, ndim=2, dtype=np.float32)
+    assert_array(obs.row_features, ndim=2, dtype=np.float32)
+    assert_array(obs.edge_features.values, dtype=np.float32)
+    assert_array(obs.edge_features.indices, ndim=2, dtype=index_dtype)
+    assert obs.VariableFeatures is ecole.observation.NodeBipartiteObs.VariableFeatures
+
+
+def test_NodeBipartite_observation_csr(model):
+    """Edges of NodeBipartite can be extracted in compressed sparse rows."""
+    coo_obs = make_obs(ecole.observation.NodeBipartiteF32I32(), model.copy_orig())
+    obs = make_obs(ecole.observation.NodeBipartiteF32I32(csr=True), model)
+    assert obs.edge_features.nnz == 0
+    assert obs.edge_features_csr.nnz == coo_obs.edge_features.nnz
+    assert_array(obs.edge_features_csr.indptr, dtype=np.int32)
+    assert obs.edge_features_csr.indptr[-1] == obs.edge_features_csr.nnz
+
+    scipy_sparse = pytest.importorskip("scipy.sparse")
+    matrix = obs.edge_features_csr.to_scipy()
+    assert isinstance(matrix, scipy_sparse.csr_matrix)
+    assert np.shares_memory(matrix.data, obs.edge_features_csr.values)
+
+
 def test_MilpBipartite_observation(model):
     """Observation of MilpBipartite is a type with array attributes."""
     obs = make_obs(ecole.observation.MilpBipartite(), model, stage=ecole.scip.Stage.Problem)
@@ -121,6 +149,15 @@ def test_StrongBranchingScores_observation(model):
     assert_array(obs)
 
 
+def test_BudgetedStrongBranchingScores_observation(model):
+    """Observation of BudgetedStrongBranchingScores flags scores of evaluated candidates as exact."""
+    obs = make_obs(ecole.observation.BudgetedStrongBranchingScores(top_k=1, n_threads=2), model)
+    assert_array(obs.scores)
+    assert_array(obs.exact, dtype=bool)
+    assert obs.exact.sum() <= 1
+    assert not np.isnan(obs.scores[obs.exact]).any()
+
+
 def test_Pseudocosts_observation(model):
     """Observation of Pseudocosts is a numpy array."""
     obs = make_obs(ecole.observation.Pseudocosts(), model)
@@ -136,6 +173,59 @@ def test_Khalil2016_observation(model):
     assert len(obs.Features.__members__) == obs.features.shape[1]
 
 
+def test_Khalil2016_observation_candidates_only(model):
+    """Compact Khalil2016 has one row per branching candidate."""
+    obs = make_obs(ecole.observation.Khalil2016(candidates_only=True), model)
+    assert_array(obs.features, ndim=2)
+    assert obs.features.shape[0] == obs.candidates.shape[0]
+    assert not np.isnan(obs.features).any()
+
+
+def test_Khalil2016_observation_extract_into(model):
+    """Khalil2016 writes in the given observation, only if its arrays keep their shape."""
+    obs_func = ecole.observation.Khalil2016()
+    obs = make_obs(obs_func, model)
+    features = obs.features
+    assert obs_func.extract_into(model, False, obs) is obs
+    assert np.shares_memory(features, obs.features)
+
+    other = copy.copy(obs)
+    other.features = np.zeros((1, obs.features.shape[1]))
+    new_obs = obs_func.extract_into(model, False, other)
+    assert new_obs is not other
+    assert np.array_equal(other.features, np.zeros((1, obs.features.shape[1])))
+    assert np.array_equal(new_obs.features, obs.features, equal_nan=True)
+
+
+def test_NodeBipartite_observation_extract_into_steps(model):
+    """NodeBipartite keeps writing in the memory of the given observation across branching steps."""
+
+    def data_pointers(obs):
+        arrays = (obs.variable_features, obs.row_features, obs.edge_features.values, obs.edge_features.indices)
+        return [arr.ctypes.data for arr in arrays]
+
+    dynamics = ecole.dynamics.BranchingDynamics()
+    obs_func = ecole.observation.NodeBipartite()
+    obs_func.before_reset(model)
+    done, action_set = dynamics.reset_dynamics(model)
+    obs = obs_func.extract(model, done)
+    pointers = data_pointers(obs)
+    for _ in range(10):
+        done, action_set = dynamics.step_dynamics(model, action_set[0])
+        if done:
+            break
+        # Cuts are disabled in the test model so the LP keeps its shape
+        assert obs_func.extract_into(model, done, obs) is obs
+        assert data_pointers(obs) == pointers
+
+
+def test_Pseudocosts_observation_candidates_only(model):
+    """Compact Pseudocosts has no NaN."""
+    obs = make_obs(ecole.observation.Pseudocosts(candidates_only=True), model)
+    assert_array(obs)
+    assert not np.isnan(obs).any()
+
+
 def test_Hutter2011_observation(model):
     """Observation of Hutter2011 is a numpy vector."""
     obs = make_obs(ecole.observation.Hutter2011(), model, stage=ecole.scip.Stage.Problem)
@@ -143,3 +233,25 @@ def test_Hutter2011_observation(model):
 
     # Check that there are enums describing feeatures
     assert len(obs.Features.__members__) == obs.features.shape[0]
+    assert_array(obs.standard_errors, ndim=1)
+    assert obs.standard_errors.shape == obs.features.shape
+
+
+def test_Hutter2011_observation_sampled(model):
+    """Variable graph features are estimated with their standard errors beyond the budget."""
+    obs_func = ecole.observation.Hutter2011(graph_budget=0, n_samples=10)
+    obs = make_obs(obs_func, model, stage=ecole.scip.Stage.Problem)
+    Features = ecole.observation.Hutter2011Obs.Features
+    assert obs.standard_errors[int(Features.nb_variables)] == 0
+    assert obs.standard_errors[int(Features.node_degree_mean)] >= 0
+    assert np.isnan(obs.standard_errors[int(Features.node_degree_max)])
+
+
+def test_Hutter2011_observation_sampled_triangles(model):
+    """Clustering coefficients are estimated beyond the triangle budget, even when the graph is built."""
+    obs_func = ecole.observation.Hutter2011(triangle_budget=0)
+    obs = make_obs(obs_func, model, stage=ecole.scip.Stage.Problem)
+    Features = ecole.observation.Hutter2011Obs.Features
+    assert obs.standard_errors[int(Features.node_degree_mean)] == 0
+    assert obs.standard_errors[int(Features.clustering_coef_mean)] >= 0
+    assert np.isnan(obs.standard_errors[int(Features.clustering_coef_std)])